@@ -0,0 +1,140 @@
+#include <print>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <random>
+#include <array>
+#include <span>
+#include <charconv>
+#include <cctype>
+#include <fstream>
+
+#include <timer.h>
+#include <string_utils.h>
+#include <cpu_dispatch.h>
+
+// The byte at a time implementation extract_numbers replaced, kept as the baseline
+template <typename T = int64_t>
+std::vector<T> extract_numbers_bytewise(std::string_view sv) {
+    std::vector<T> numbers;
+    const char* ptr = sv.data();
+    const char* end = sv.data() + sv.size();
+
+    while (ptr < end) {
+        bool is_sign = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (*ptr == '-') {
+                if (ptr + 1 < end && std::isdigit(*(ptr + 1))) {
+                    is_sign = true;
+                }
+            }
+        }
+
+        if (!std::isdigit(*ptr) && !is_sign) {
+            ++ptr;
+            continue;
+        }
+
+        T value;
+        auto result = std::from_chars(ptr, end, value);
+
+        if (result.ec == std::errc()) {
+            numbers.push_back(value);
+            ptr = result.ptr;
+        } else {
+            ++ptr;
+        }
+    }
+    return numbers;
+}
+
+// Day 8 style lines, "x,y,z" with coordinates up to 99999
+std::vector<std::string> make_lines(std::size_t n, std::uint32_t seed = 8) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int64_t> coord(0, 99999);
+    std::vector<std::string> lines;
+    lines.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        lines.push_back(std::format("{},{},{}", coord(rng), coord(rng), coord(rng)));
+    }
+    return lines;
+}
+
+// Usage: bench_extract_numbers [lines] [json file]
+//   lines  Number of generated lines, default 1000000
+int main(int argc, char** argv){
+    std::size_t n = 1'000'000;
+    if (argc >= 2) {
+        auto lines_arg = StringUtils::try_to_num<std::size_t>(argv[1]);
+        if (!lines_arg) {
+            std::println(stderr, "Usage: {} [lines] [json file]", argv[0]);
+            return 2;
+        }
+        n = *lines_arg;
+    }
+    auto lines = make_lines(n);
+
+    // Both implementations must agree
+    for (const auto& line : lines) {
+        if (extract_numbers_bytewise<int64_t>(line) != StringUtils::extract_numbers<int64_t>(line)) {
+            std::println(stderr, "Mismatch on line '{}'", line);
+            return 1;
+        }
+    }
+
+    auto bytewise = Timer::benchmark("Bytewise, new vector", [&]{
+        int64_t sum = 0;
+        for (const auto& line : lines) {
+            auto vs = extract_numbers_bytewise<int64_t>(line);
+            sum += vs[0] + vs[1] + vs[2];
+        }
+        Timer::do_not_optimize(sum);
+    });
+
+    auto vectorised = Timer::benchmark("Vectorised, new vector", [&]{
+        int64_t sum = 0;
+        for (const auto& line : lines) {
+            auto vs = StringUtils::extract_numbers<int64_t>(line);
+            sum += vs[0] + vs[1] + vs[2];
+        }
+        Timer::do_not_optimize(sum);
+    });
+
+    auto buffered = Timer::benchmark("Vectorised, buffer", [&]{
+        int64_t sum = 0;
+        std::array<int64_t, 3> vs{};
+        for (const auto& line : lines) {
+            StringUtils::extract_numbers(line, std::span(vs));
+            sum += vs[0] + vs[1] + vs[2];
+        }
+        Timer::do_not_optimize(sum);
+    });
+
+    std::vector<Timer::BenchmarkResult> results = {bytewise, vectorised, buffered};
+
+    // The buffered variant again at every instruction set level this CPU supports
+    for (std::size_t l = 0; l <= static_cast<std::size_t>(CpuDispatch::supported()); ++l) {
+        auto level = static_cast<CpuDispatch::Level>(l);
+        CpuDispatch::ForceScope force(level);
+        results.push_back(Timer::benchmark(std::format("Vectorised, buffer, {}", CpuDispatch::name(level)), [&]{
+            int64_t sum = 0;
+            std::array<int64_t, 3> vs{};
+            for (const auto& line : lines) {
+                StringUtils::extract_numbers(line, std::span(vs));
+                sum += vs[0] + vs[1] + vs[2];
+            }
+            Timer::do_not_optimize(sum);
+        }));
+    }
+
+    std::println("{} lines, dispatching to {}", n, CpuDispatch::name(CpuDispatch::level()));
+    for (const auto& r : results) {
+        r.print();
+        std::println("    {:.2f}x vs bytewise", bytewise.median / r.median);
+    }
+
+    // Optional machine readable results
+    if (argc >= 3) {
+        std::ofstream(argv[2]) << Timer::to_json(results) << "\n";
+    }
+}
@@ -0,0 +1,117 @@
+#include <print>
+#include <vector>
+#include <string>
+#include <random>
+#include <fstream>
+
+#include <timer.h>
+#include <grid.h>
+#include <grid_graph.h>
+#include <string_utils.h>
+
+// BFS over a large random maze in each Grid storage layout
+// Usage: bench_grid_layout [side] [json file]
+//   side  Width and height of the maze, default 2000
+// Morton pads each side to a power of two, so sides just above one cost up to 4x the memory
+
+// About a quarter walls, well above the percolation threshold so most open cells are connected
+std::vector<std::string> make_maze(std::size_t side, std::uint32_t seed = 24) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution wall(0.25);
+    std::vector<std::string> lines(side, std::string(side, '.'));
+    for (auto& line : lines) {
+        for (auto& c : line) c = wall(rng) ? '#' : '.';
+    }
+    // An open top row and right column join both corners to the large connected region
+    for (auto& c : lines.front()) c = '.';
+    for (auto& line : lines) line.back() = '.';
+    return lines;
+}
+
+template<typename Layout>
+struct LayoutBench {
+    Grid::Grid<char, Layout> grid;
+    std::vector<int> dist;
+
+    LayoutBench(const std::vector<std::string>& lines) : grid(lines, 1, '#') {}
+
+    static bool open(const Grid::Grid<char, Layout>& g, std::size_t, std::size_t to) { return g[to] != '#'; }
+
+    void map() { dist = Grid::bfs_map(grid, grid.index_of(0, 0), open); }
+
+    std::size_t path() {
+        auto p = Grid::bfs_path(grid, grid.index_of(0, 0), grid.index_of(grid.rows - 1, grid.cols - 1), open);
+        return p ? p->size() : 0;
+    }
+
+    // Distance of every cell in row-major order, to compare layouts
+    std::vector<int> distances() const {
+        std::vector<int> out;
+        out.reserve(grid.rows * grid.cols);
+        for (std::size_t r = 0; r < grid.rows; ++r) {
+            for (std::size_t c = 0; c < grid.cols; ++c) out.push_back(dist[grid.index_of(r, c)]);
+        }
+        return out;
+    }
+};
+
+int main(int argc, char** argv){
+    std::size_t side = 2000;
+    if (argc >= 2) {
+        auto side_arg = StringUtils::try_to_num<std::size_t>(argv[1]);
+        if (!side_arg || *side_arg == 0) {
+            std::println(stderr, "Usage: {} [side] [json file]", argv[0]);
+            return 2;
+        }
+        side = *side_arg;
+    }
+    auto lines = make_maze(side);
+
+    LayoutBench<Grid::RowMajor> row_major(lines);
+    LayoutBench<Grid::Tiled8> tiled(lines);
+    LayoutBench<Grid::Morton> morton(lines);
+
+    // Every layout must find the same distances and path length
+    row_major.map();
+    tiled.map();
+    morton.map();
+    auto expected = row_major.distances();
+    if (tiled.distances() != expected || morton.distances() != expected) {
+        std::println(stderr, "Layouts disagree on BFS distances");
+        return 1;
+    }
+    std::size_t path = row_major.path();
+    if (tiled.path() != path || morton.path() != path) {
+        std::println(stderr, "Layouts disagree on the BFS path length");
+        return 1;
+    }
+
+    Timer::BenchmarkOptions options;
+    options.target_time = 2.0;
+    options.min_runs = 3;
+
+    std::vector<Timer::BenchmarkResult> results;
+    auto bench = [&](auto& layout, std::string_view name){
+        results.push_back(Timer::benchmark(std::format("bfs_map, {}", name), [&]{
+            layout.map();
+            Timer::do_not_optimize(layout.dist);
+        }, options));
+        results.push_back(Timer::benchmark(std::format("bfs_path, {}", name), [&]{
+            Timer::do_not_optimize(layout.path());
+        }, options));
+    };
+    bench(row_major, "row-major");
+    bench(tiled, "tiled 8x8");
+    bench(morton, "morton");
+
+    std::println("{0}x{0} maze, shortest corner to corner path {1} cells", side, path);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        results[i].print();
+        std::println("    {:.2f}x vs row-major", results[i % 2].median / results[i].median);
+    }
+
+    // Optional machine readable results
+    if (argc >= 3) {
+        std::ofstream(argv[2]) << Timer::to_json(results) << "\n";
+    }
+}
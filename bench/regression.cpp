@@ -0,0 +1,243 @@
+// Defines the replacement operator new/delete when built with AOC_TRACK_ALLOCATIONS
+#define AOC_ALLOC_TRACKER_IMPL
+#include <print>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <map>
+#include <charconv>
+
+#include <timer.h>
+#include <solver.h>
+#include <string_utils.h>
+#include <snapshot.h>
+
+// Performance regression suite
+// Benchmarks the parse, part 1 and part 2 phases of every registered day and compares the
+// medians against a stored baseline, exiting non-zero if any phase got slower than allowed
+//
+// Usage: aoc_bench [days...] [--baseline file] [--update] [--tolerance x] [--time seconds] [--inputs dir]
+//   --baseline   JSON Lines file, one benchmark result per phase, default bench_baseline.jsonl
+//   --update     Write the baseline instead of comparing, also done when it does not exist yet
+//   --tolerance  Allowed relative slowdown for phases new to the baseline, default 0.1
+//   --time       Seconds of measured runs per phase, default 0.5
+//   --inputs     Read dir/dayN/input.txt for every day instead of embedded input
+//
+// Each baseline line carries its own "tolerance", edit it to loosen or tighten a single phase
+
+struct Options {
+    std::vector<int> days;
+    std::string baseline = "bench_baseline.jsonl";
+    bool update = false;
+    double tolerance = 0.1;
+    double time = 0.5;
+    std::optional<std::string> inputs;
+};
+
+// Slowdowns below this are noise whatever the tolerance, matters for phases of a few µs
+constexpr double ABSOLUTE_SLACK = 5e-6;
+
+struct Phase {
+    Timer::BenchmarkResult result;
+    double tolerance = 0.0;
+    std::string line; // Baseline entry as read, only medians and tolerances are parsed back
+};
+
+std::optional<Options> parse_args(int argc, char** argv){
+    auto usage = [&]{
+        std::println(stderr, "Usage: {} [days...] [--baseline file] [--update] [--tolerance x] [--time seconds] [--inputs dir]", argv[0]);
+        return std::nullopt;
+    };
+    // Value following option i, nullopt when it is missing
+    auto value = [&](int& i) -> std::optional<std::string_view> {
+        if(i + 1 >= argc) return std::nullopt;
+        return argv[++i];
+    };
+
+    Options options;
+    for(int i = 1; i < argc; i++){
+        std::string_view arg = argv[i];
+        if(arg == "--update"){
+            options.update = true;
+        }else if(arg == "--baseline" || arg == "--inputs"){
+            auto v = value(i);
+            if(!v) return usage();
+            if(arg == "--baseline") options.baseline = *v;
+            else options.inputs = std::string(*v);
+        }else if(arg == "--tolerance" || arg == "--time"){
+            auto v = value(i);
+            auto x = v ? StringUtils::try_to_num<double>(*v) : std::nullopt;
+            if(!x || *x < 0.0) return usage();
+            if(arg == "--tolerance") options.tolerance = *x;
+            else options.time = *x;
+        }else if(auto day = StringUtils::try_to_num<int>(arg); day && arg.front() != '-'){
+            options.days.push_back(*day);
+        }else{
+            return usage();
+        }
+    }
+    return options;
+}
+
+// Value of a top level key in one of our own JSON lines, enough for the files this writes
+std::optional<std::string_view> json_field(std::string_view line, std::string_view key){
+    std::string pattern = std::format("\"{}\":", key);
+    auto pos = line.find(pattern);
+    if(pos == std::string_view::npos) return std::nullopt;
+    pos += pattern.size();
+    if(pos >= line.size()) return std::nullopt;
+
+    if(line[pos] == '"'){
+        auto end = line.find('"', pos + 1);
+        if(end == std::string_view::npos) return std::nullopt;
+        return line.substr(pos + 1, end - pos - 1);
+    }
+    // A truncated line has no closing ',' or '}'
+    auto end = line.find_first_of(",}", pos);
+    if(end == std::string_view::npos) return std::nullopt;
+    return line.substr(pos, end - pos);
+}
+
+std::optional<double> json_number(std::string_view line, std::string_view key){
+    auto field = json_field(line, key);
+    if(!field) return std::nullopt;
+    double v = 0.0;
+    auto [ptr, ec] = std::from_chars(field->data(), field->data() + field->size(), v);
+    if(ec != std::errc()) return std::nullopt;
+    return v;
+}
+
+// Baseline medians and tolerances by phase name
+std::map<std::string, Phase> read_baseline(const std::string& path){
+    std::map<std::string, Phase> phases;
+    std::ifstream in(path);
+    std::string line;
+    while(std::getline(in, line)){
+        auto name = json_field(line, "name");
+        auto median = json_number(line, "median");
+        if(!name || !median) continue;
+
+        Phase p;
+        p.result.name = std::string(*name);
+        p.result.median = *median;
+        p.tolerance = json_number(line, "tolerance").value_or(0.1);
+        p.line = line;
+        phases[p.result.name] = p;
+    }
+    return phases;
+}
+
+bool write_baseline(const std::string& path, const std::vector<Phase>& phases, const std::map<std::string, Phase>& old){
+    std::ofstream out(path, std::ios::trunc);
+    if(!out) return false;
+    for(const auto& p : phases){
+        if(!p.line.empty()){
+            out << p.line << "\n";
+            continue;
+        }
+        // Keep hand tuned tolerances across updates
+        double tolerance = old.contains(p.result.name) ? old.at(p.result.name).tolerance : p.tolerance;
+        std::string json = p.result.to_json();
+        json.pop_back();
+        out << json << ",\"tolerance\":" << tolerance << "}\n";
+    }
+    return static_cast<bool>(out);
+}
+
+// Benchmark every phase of a day, the parts run on a single parsed input
+std::vector<Phase> bench_day(const Solver::Day& day, const Options& options){
+    std::vector<Phase> phases;
+    std::string path = Solver::input_path(day, options.inputs);
+    if(!path.empty() && !std::filesystem::exists(path)){
+        std::println(stderr, "Skipping day {}: missing input '{}'", day.number, path);
+        return phases;
+    }
+
+    Timer::BenchmarkOptions bench_options;
+    bench_options.target_time = options.time;
+    auto add = [&](std::string_view phase, auto&& f){
+        auto result = Timer::benchmark(std::format("day{}/{}", day.number, phase), f, bench_options);
+        result.print();
+        phases.push_back(Phase{result, options.tolerance});
+    };
+
+    add("parse", [&]{
+        auto input = day.parse(path);
+        Timer::do_not_optimize(input);
+    });
+
+    Solver::Input input = day.parse(path);
+    add("p1", [&]{
+        auto answer = day.p1(input);
+        Timer::do_not_optimize(answer);
+    });
+    if(day.p2){
+        add("p2", [&]{
+            auto answer = day.p2(input);
+            Timer::do_not_optimize(answer);
+        });
+    }
+    return phases;
+}
+
+// Print each phase against the baseline, true if none regressed
+bool compare(const std::vector<Phase>& phases, const std::map<std::string, Phase>& baseline){
+    std::println("\n{:<12} {:>12} {:>12} {:>9} {:>9}  {}", "Phase", "Baseline", "Current", "Change", "Allowed", "Status");
+
+    bool ok = true;
+    for(const auto& p : phases){
+        const auto& name = p.result.name;
+        if(!baseline.contains(name)){
+            std::println("{:<12} {:>12} {:>12} {:>9} {:>9}  new", name, "-", Timer::formatTime(p.result.median), "-", "-");
+            continue;
+        }
+
+        const auto& base = baseline.at(name);
+        double change = base.result.median > 0.0 ? p.result.median / base.result.median - 1.0 : 0.0;
+        bool regressed = p.result.median > base.result.median * (1.0 + base.tolerance) + ABSOLUTE_SLACK;
+        ok = ok && !regressed;
+
+        std::println("{:<12} {:>12} {:>12} {:>+8.1f}% {:>8.1f}%  {}", name,
+                     Timer::formatTime(base.result.median), Timer::formatTime(p.result.median),
+                     change * 100.0, base.tolerance * 100.0, regressed ? "REGRESSION" : "ok");
+    }
+    return ok;
+}
+
+int main(int argc, char** argv){
+    auto options = parse_args(argc, argv);
+    if(!options) return 2;
+
+    Solver::set_quiet(true);
+    // Parse phases time the real parser, not a load of a day's snapshot cache
+    Snapshot::enabled = false;
+
+    std::vector<Phase> phases;
+    for(const auto& day : Solver::days()){
+        if(!options->days.empty() && !std::ranges::contains(options->days, day.number)) continue;
+        auto day_phases = bench_day(day, *options);
+        phases.insert(phases.end(), day_phases.begin(), day_phases.end());
+    }
+
+    auto baseline = read_baseline(options->baseline);
+    if(options->update || baseline.empty()){
+        // Phases not benchmarked this time keep their old entry
+        for(const auto& [name, p] : baseline){
+            if(!std::ranges::contains(phases, name, [](const Phase& q){ return q.result.name; })){
+                phases.push_back(p);
+            }
+        }
+        if(!write_baseline(options->baseline, phases, baseline)){
+            std::println(stderr, "Error: Failed to write baseline '{}'.", options->baseline);
+            return 2;
+        }
+        std::println("Wrote baseline: {}", options->baseline);
+        return 0;
+    }
+
+    return compare(phases, baseline) ? 0 : 1;
+}
@@ -10,21 +10,8 @@
 #endif
 
 // Embed input at compile time
-constexpr const char input[] = {
-    #embed "../inputs/day1/input.txt"
-    , '\0'   
-};
-constexpr std::string_view input_sv = input;
-
-// Count lines at compile time
-consteval std::size_t count_lines(std::string_view text) {
-    std::size_t count = 0;
-    for (char c : text)
-        if (c == '\n') ++count;
-    if (!text.empty() && text.back() != '\n')
-        ++count;
-    return count;
-}
+#define AOC_INPUT_FILE_PATH "../inputs/day1/input.txt"
+#include <input.h>
 
 struct Move {
     char direction;
@@ -32,7 +19,7 @@ struct Move {
 };
 
 // Parse line into a move
-consteval Move parse_line(std::string_view line) {
+constexpr Move parse_line(std::string_view line) {
     Move m{};
     m.direction = line[0];
     int v = 0;
@@ -42,26 +29,8 @@ consteval Move parse_line(std::string_view line) {
     return m;
 }
 
-// Loop over lines in input and parse into move array
-consteval auto parse_moves() {
-    std::array<Move, count_lines(input_sv)> result{};
-    size_t idx = 0;
-
-    size_t pos = 0;
-    while (pos < input_sv.size()) {
-        size_t nl = input_sv.find('\n', pos);
-        if (nl == std::string_view::npos) nl = input_sv.size();
-        auto line = input_sv.substr(pos, nl - pos);
-
-        result[idx++] = parse_line(line);
-
-        pos = nl + 1;
-    }
-    return result;
-}
-
 consteval std::pair<int, int> p1_2(){
-    constexpr auto moves = parse_moves();
+    constexpr auto moves = InputUtils::parse_embedded<Move>(parse_line);
 
     int val = 50;
     int p1 = 0;
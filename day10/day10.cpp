@@ -27,6 +27,9 @@
 #include <input.h>
 #include <string_utils.h>
 #include <grid.h>
+#include <solver.h>
+
+namespace day10 {
 
 struct Machine {
     uint64_t ind_light = uint64_t{0};
@@ -36,25 +39,29 @@ struct Machine {
     auto operator<=>(const Machine&) const = default;
 };
 
+} // namespace day10
+
 template <>
-struct std::formatter<Machine> {
+struct std::formatter<day10::Machine> {
     constexpr auto parse(std::format_parse_context& ctx) {
         return ctx.begin();
     }
     template <typename FormatContext>
-    auto format(const Machine& m, FormatContext& ctx) const {
+    auto format(const day10::Machine& m, FormatContext& ctx) const {
         return std::format_to(ctx.out(), "Machine(ind_light={:#b}, buttons={}, joltage={})", m.ind_light, m.buttons, m.joltage);
     }
 };
 
 template <>
-struct std::formatter<std::vector<Machine>> : std::range_formatter<Machine> {
+struct std::formatter<std::vector<day10::Machine>> : std::range_formatter<day10::Machine> {
     constexpr formatter() {
         this->set_separator("\n");
         this->set_brackets("[", "]");
     }
 };
 
+namespace day10 {
+
 auto parse_input(std::string input_file = ""){
     Timer::ScopedTimer t_("Input Parsing");
 
@@ -85,7 +92,7 @@ auto parse_input(std::string input_file = ""){
         machines.push_back(m);
     };
 
-    return InputUtils::parse_input<std::vector<Machine>>(parse_line, input_file);
+    return InputUtils::parse_input_parallel<std::vector<Machine>>(parse_line, input_file);
 }
 
 auto p1(auto input){
@@ -206,12 +213,19 @@ auto p2(const auto& input){
     return p2;
 }
 
+} // namespace day10
+
+AOC_REGISTER_DAY(10, day10::parse_input, day10::p1, day10::p2);
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day10;
     Timer::ScopedTimer t_("Total");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
 }
+#endif
 
 
 /*
@@ -25,8 +25,11 @@
 #include <input.h>
 #include <string_utils.h>
 #include <grid.h>
+#include <solver.h>
 
 
+namespace day11 {
+
 auto parse_input(std::string input_file = ""){
     Timer::ScopedTimer t_("Input Parsing");
 
@@ -38,16 +41,17 @@ auto parse_input(std::string input_file = ""){
         for(const auto& match : ctre::search_all<pattern>(line)) {
             auto key = match.get<"key">().to_view();
             auto vals_str = match.get<"vals">().to_view();
-            auto vals = StringUtils::split(vals_str, ' ');
-            points[std::string(key)] = std::vector<std::string>{};
-            for(const auto& v : vals){
-                points[std::string(key)].push_back(std::string(v));
+            auto& neighbours = points[std::string(key)];
+            neighbours.clear();
+            for(const auto v : StringUtils::split_view(vals_str, ' ')){
+                neighbours.emplace_back(v);
             }
         }
 
     };
 
-    return InputUtils::parse_input<std::map<std::string, std::vector<std::string>>>(parse_line, input_file);
+    // A device listed twice keeps its last line, across chunks as well as within one
+    return InputUtils::parse_input_parallel<std::map<std::string, std::vector<std::string>>>(parse_line, input_file, InputUtils::OverwriteKeys{});
 }
 
 
@@ -115,12 +119,19 @@ auto p2(auto& input){
     return svr_to_fft * fft_to_dac * dac_to_out + svr_to_dac * dac_to_fft * fft_to_out;
 }
 
+} // namespace day11
+
+AOC_REGISTER_DAY(11, day11::parse_input, day11::p1, day11::p2);
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day11;
     Timer::ScopedTimer t_("Total");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
 }
+#endif
 
 
 /*
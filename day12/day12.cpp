@@ -25,6 +25,9 @@
 #include <input.h>
 #include <string_utils.h>
 #include <grid.h>
+#include <solver.h>
+
+namespace day12 {
 
 struct Present{
     std::vector<std::vector<char>> shape;
@@ -97,7 +100,7 @@ auto parse_input(std::string input_file = ""){
     Timer::ScopedTimer t_("Input Parsing");
 
     bool presents = true;
-    static auto parse_line = [&presents](std::string_view line, Input& input) {
+    auto parse_line = [&presents](std::string_view line, Input& input) {
         static constexpr auto region_pattern = ctll::fixed_string{ 
             R"(^(\d+)x(\d+): ((\d+ )*\d+)$)" 
         };
@@ -136,7 +139,28 @@ auto parse_input(std::string input_file = ""){
     return InputUtils::parse_input<Input>(parse_line, input_file);
 }
 
+// Replace every present with its unique flips and rotations
+void add_variants(Input& input){
+    for(auto& pres : input.presents){
+        // Only generate from the base shape
+        auto all_variants = Present::generate_flipped_rotations(pres[0].shape);
+        
+        std::set<std::vector<std::vector<char>>> unique_shapes;
+        for(const auto& r : all_variants){
+            unique_shapes.insert(r.shape);
+        }
+
+        // Replace the vector with all unique variants
+        pres.clear();
+        for(const auto& us : unique_shapes){
+            pres.push_back(Present{us});
+        }
+    }
+}
+
 auto stamp_present(std::vector<std::vector<char>>& grid, const Present& pres, int top, int left){
+    PROFILE_SCOPE("stamp_present");
+
     auto tgrid = grid;
     
     int pres_height = pres.shape.size();
@@ -247,29 +271,25 @@ auto p1(auto& input){
 }
 
 
+} // namespace day12
+
+AOC_REGISTER_DAY(12, [](const std::string& path) {
+                     auto input = day12::parse_input(path);
+                     day12::add_variants(input);
+                     return input;
+                 },
+                 day12::p1, Solver::no_part);
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day12;
     Timer::ScopedTimer t_("Total");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
-
-    for(auto& pres : input.presents){
-        // Only generate from the base shape
-        auto all_variants = Present::generate_flipped_rotations(pres[0].shape);
-        
-        std::set<std::vector<std::vector<char>>> unique_shapes;
-        for(const auto& r : all_variants){
-            unique_shapes.insert(r.shape);
-        }
-
-        // Replace the vector with all unique variants
-        pres.clear();
-        for(const auto& us : unique_shapes){
-            pres.push_back(Present{us});
-        }
-    }
-
+    add_variants(input);
 
     std::println("Part 1: {}", p1(input));
 }
+#endif
 
 
 /*
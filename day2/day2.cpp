@@ -9,25 +9,28 @@
 #include <cmath>
 
 #include <timer.h>
+#include <input.h>
+#include <solver.h>
+
+namespace day2 {
 
 struct range{
     std::uint64_t from;
     std::uint64_t to;
 };
 
-auto parse_input(){
-    std::string linetxt;
-    std::vector<range> ranges;
-    static constexpr auto re = ctll::fixed_string{R"((\d+)-(\d+))"};
-    while(std::getline(std::cin, linetxt)){
-        for (auto m : ctre::search_all<re>(linetxt)) {
+auto parse_input(std::string input_file = ""){
+    static auto parse_line = [](std::string_view line, std::vector<range>& ranges){
+        static constexpr auto re = ctll::fixed_string{R"((\d+)-(\d+))"};
+        for (auto m : ctre::search_all<re>(line)) {
             auto first  = m.get<1>().to_number<std::uint64_t>();
             auto second = m.get<2>().to_number<std::uint64_t>();
 
             ranges.emplace_back(range{first, second});
         }
-    }
-    return ranges;
+    };
+
+    return InputUtils::parse_input<std::vector<range>>(parse_line, input_file);
 }
 
 std::uint64_t p1(const auto& ranges){
@@ -90,8 +93,15 @@ std::uint64_t p2_2(const auto& ranges){
     });
 }
 
-int main(){
-    auto input = parse_input();
+} // namespace day2
+
+AOC_REGISTER_DAY(2, day2::parse_input, day2::p1, day2::p2);
+
+#ifndef AOC_RUNNER
+int main(int argc, char** argv){
+    using namespace day2;
+    auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
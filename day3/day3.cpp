@@ -9,15 +9,17 @@
 #include <numeric>
 
 #include <timer.h>
+#include <input.h>
+#include <solver.h>
 
-auto parse_input(){
-    std::string linetxt;
-    std::vector<std::string> batteries;
-    while(std::getline(std::cin, linetxt)){
-        batteries.push_back(linetxt);
-    }
+namespace day3 {
+
+auto parse_input(std::string input_file = ""){
+    static auto parse_line = [](std::string_view line, std::vector<std::string>& batteries){
+        batteries.emplace_back(line);
+    };
 
-    return batteries;
+    return InputUtils::parse_input<std::vector<std::string>>(parse_line, input_file);
 }
 
 auto inline find_max(std::string_view s, int s_idx, int n){
@@ -60,8 +62,15 @@ uint64_t p2(const auto input){
     });
 }
 
-int main(){
-    auto input = parse_input();
+} // namespace day3
+
+AOC_REGISTER_DAY(3, day3::parse_input, day3::p1, day3::p2);
+
+#ifndef AOC_RUNNER
+int main(int argc, char** argv){
+    using namespace day3;
+    auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
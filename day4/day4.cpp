@@ -15,6 +15,9 @@
 #define AOC_INPUT_FILE_PATH "../inputs/day4/input.txt"
 #include <input.h>
 #include <grid.h>
+#include <solver.h>
+
+namespace day4 {
 
 auto parse_input(std::string input_file){
     Timer::ScopedTimer t_("Input Parsing");
@@ -31,27 +34,25 @@ auto parse_input(std::string input_file){
 auto p1(auto input){
     Timer::ScopedTimer _t("Part 1");
 
-    auto indices = std::views::iota(0u, input.data.size());
-
-    return std::ranges::count_if(indices, [&](std::size_t idx){
-        if(input[idx] != '@') return false;
-        return input.count_neighbours(idx, '@') < 4;
-    });
+    // Rolls with fewer than 4 neighbouring rolls, 64 cells at a time
+    Grid::BitGrid rolls(input, '@');
+    return (rolls.neighbours_below(4) & rolls).count();
 }
 
 auto p2(auto input){
     Timer::ScopedTimer _t("Part 2");
 
-    std::vector<int> counts(input.data.size(), 0);
+    // Same shape as the input, so indices are shared
+    Grid::Grid<int> counts(input.rows, input.cols, input.padding);
     std::vector<size_t> q;
     q.reserve(input.data.size() / 4);
 
     // Calculate neighbour counts for all '@'
-    for(std::size_t i = 0; i < input.data.size(); i++){
-        if(input[i] == '@'){
-            counts[i] = input.count_neighbours(i, '@');
-        }
-    }
+    Grid::stencil(input, counts, [](const auto& n){
+        if(n.centre != '@') return 0;
+        return (n.nw == '@') + (n.n == '@') + (n.ne == '@') + (n.w == '@')
+             + (n.e == '@') + (n.sw == '@') + (n.s == '@') + (n.se == '@');
+    });
 
     // Identify initial deaths
     int removed_count = 0;
@@ -86,12 +87,19 @@ auto p2(auto input){
     return removed_count;
 }
 
+} // namespace day4
+
+AOC_REGISTER_DAY(4, day4::parse_input, day4::p1, day4::p2);
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day4;
     Timer::ScopedTimer t_("Total");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
 }
+#endif
 
 
 /*
@@ -16,6 +16,9 @@
 
 #include <input.h>
 #include <string_utils.h>
+#include <solver.h>
+
+namespace day5 {
 
 struct Input{
     std::vector<std::pair<uint64_t, uint64_t>> rs;
@@ -81,12 +84,19 @@ auto p2(const auto& input){
     });
 }
 
+} // namespace day5
+
+AOC_REGISTER_DAY(5, day5::parse_input, day5::p1, day5::p2);
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day5;
     Timer::ScopedTimer t_("Total");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
 }
+#endif
 
 
 /*
@@ -9,6 +9,7 @@
 #include <numeric>
 #include <string_view>
 #include <fstream>
+#include <memory>
 
 #include <timer.h>
 
@@ -17,27 +18,30 @@
 #include <input.h>
 #include <string_utils.h>
 #include <grid.h>
+#include <solver.h>
 
 #define DOUBLE_PARSING true
 
+namespace day6 {
+
 struct Input{
     std::vector<std::vector<uint64_t>> vs;
     std::vector<char> ops;
 };
 
 
+// The worksheet viewed in place, the source keeps the text alive
+struct Worksheet {
+    std::shared_ptr<InputUtils::InputSource> source;
+    Grid::GridView<char> grid;
+};
+
 auto parse_input(std::string input_file = ""){
     Timer::ScopedTimer t_("Input Parsing");
 
-    
-
-    auto line_collector = [](std::string_view line, std::vector<std::string>& lines) {
-        lines.emplace_back(line);
-    };
-
-    auto lines = InputUtils::parse_input<std::vector<std::string>>(line_collector, input_file);
-
-    Grid::Grid i2 = Grid::Grid<char>(lines, 1, ' ');
+    Worksheet i2;
+    i2.source = std::make_shared<InputUtils::InputSource>(input_file);
+    i2.grid = Grid::GridView<char>(i2.source->view());
 
 #if DOUBLE_PARSING
     auto parse_line = [&](std::string_view linetxt, auto& i){
@@ -46,13 +50,15 @@ auto parse_input(std::string input_file = ""){
             i.ops.insert(i.ops.begin(), ops.begin(), ops.end());
         }else{
             i.vs.emplace_back(std::vector<uint64_t>());
-            i.vs.back() = StringUtils::extract_numbers<uint64_t>(linetxt);
+            StringUtils::extract_numbers(linetxt, i.vs.back());
         }
     };
     
-    Input i1 =  InputUtils::parse_input<Input>(parse_line, input_file);
+    // Same text, no second read
+    Input i1;
+    InputUtils::parse_lines(i2.source->view(), parse_line, i1);
 
-    return std::pair<Input, Grid::Grid<char>>{i1, i2};
+    return std::pair<Input, Worksheet>{i1, i2};
 #else
     return i2;
 #endif
@@ -199,20 +205,35 @@ auto p2(const auto& input){
     return total + block_total;
 }
 
+} // namespace day6
+
+#if DOUBLE_PARSING
+AOC_REGISTER_DAY(6, day6::parse_input,
+                 [](auto& input) { return day6::p1(input.first); },
+                 [](auto& input) { return day6::p2(input.second.grid); });
+#else
+AOC_REGISTER_DAY(6, day6::parse_input,
+                 [](auto& input) { return day6::p1_2(input.grid); },
+                 [](auto& input) { return day6::p2(input.grid); });
+#endif
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day6;
     Timer::ScopedTimer t_("Total");
 #if DOUBLE_PARSING
     std::println("Double parsing");
     auto[input1, input2] = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input1));
-    std::println("Part 2: {}", p2(input2));
+    std::println("Part 2: {}", p2(input2.grid));
 #else
     std::println("Single parsing");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
-    std::println("Part 1_2: {}", p1_2(input));
-    std::println("Part 2: {}", p2(input));
+    std::println("Part 1_2: {}", p1_2(input.grid));
+    std::println("Part 2: {}", p2(input.grid));
 #endif
 }
+#endif
 
 
 /*
@@ -17,6 +17,9 @@
 #include <input.h>
 #include <string_utils.h>
 #include <grid.h>
+#include <solver.h>
+
+namespace day7 {
 
 auto parse_input(std::string input_file = ""){
     Timer::ScopedTimer t_("Input Parsing");
@@ -37,7 +40,8 @@ auto parse_input(std::string input_file = ""){
     return Grid::Grid<int64_t>(lines, map);
 }
 
-auto p1_2(auto& input){
+// Takes a copy, the beams are accumulated in place
+auto p1_2(auto input){
     Timer::ScopedTimer _t("Parts 1 and 2");
     int splits = 0;
     for(const auto row : std::views::iota(0u, input.rows)){
@@ -57,11 +61,18 @@ auto p1_2(auto& input){
     })};
 }
 
+} // namespace day7
+
+AOC_REGISTER_DAY(7, day7::parse_input, day7::p1_2, Solver::no_part);
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day7;
     Timer::ScopedTimer t_("Total");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part (1, 2): {}", p1_2(input));
 }
+#endif
 
 
 /*
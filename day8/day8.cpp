@@ -12,6 +12,8 @@
 #include <map>
 #include <compare>
 #include <limits>
+#include <array>
+#include <span>
 
 #include <timer.h>
 
@@ -20,6 +22,16 @@
 #include <input.h>
 #include <string_utils.h>
 #include <grid.h>
+#include <snapshot.h>
+#include <solver.h>
+
+// Cache the parsed points and sorted pairs between runs in a .snap file next to the input
+// Off by default as it writes into the inputs, enable with the AOC_SNAPSHOTS CMake option
+#ifndef USE_SNAPSHOT
+    #define USE_SNAPSHOT false
+#endif
+
+namespace day8 {
 
 struct Point{
     int64_t x, y, z;
@@ -35,28 +47,33 @@ struct __attribute__((packed)) PointPair {
     auto operator<=>(const PointPair&) const = default;
 };
 
+} // namespace day8
+
 template <>
-struct std::formatter<Point> {
+struct std::formatter<day8::Point> {
     constexpr auto parse(std::format_parse_context& ctx) {
         return ctx.begin();
     }
     template <typename FormatContext>
-    auto format(const Point& p, FormatContext& ctx) const {
+    auto format(const day8::Point& p, FormatContext& ctx) const {
         return std::format_to(ctx.out(), "Point(x={}, y={}, z={})", p.x, p.y, p.z);
     }
 };
 
 template <>
-struct std::formatter<std::vector<Point>> : std::range_formatter<Point> {
+struct std::formatter<std::vector<day8::Point>> : std::range_formatter<day8::Point> {
     constexpr formatter() {
         this->set_separator("\n");
         this->set_brackets("[", "]");
     }
 };
 
+namespace day8 {
+
 // Radix sort for O(n) sorting by distSquared
 // Significantly faster than std::sort
 void radix_sort_pairs(std::vector<PointPair>& source) {
+    PERF_SCOPE("radix_sort_pairs");
     const size_t n = source.size();
     if (n == 0) return;
 
@@ -188,18 +205,20 @@ auto find_threshold(const std::vector<Point>& points){
 auto parse_input(std::string input_file = ""){
     Timer::ScopedTimer t_("Input Parsing");
 
-    static auto line_collector = [](std::string_view line, std::vector<Point>& points) {
-        auto vs = StringUtils::extract_numbers<int64_t>(line);
-        points.emplace_back(Point{vs[0], vs[1], vs[2]});
-    };
+    // Parse into one column per coordinate, sorted by x
+    auto table = InputUtils::parse_numeric_table<int64_t, 3>(input_file);
+    table.permute(table.order_by(0));
 
-    auto input = InputUtils::parse_input<std::vector<Point>>(line_collector, input_file);
+    const auto& xs = table[0];
+    const auto& ys = table[1];
+    const auto& zs = table[2];
 
-    int n = input.size();
+    int n = table.size();
 
-    std::sort(input.begin(), input.end(), [](const Point& a, const Point& b) {
-        return a.x < b.x;
-    });
+    std::vector<Point> input(n);
+    for (int i = 0; i < n; ++i) {
+        input[i] = Point{xs[i], ys[i], zs[i]};
+    }
 
     uint64_t limit = find_threshold(input);
 
@@ -207,13 +226,11 @@ auto parse_input(std::string input_file = ""){
     std::vector<PointPair> pairs;
     pairs.reserve(n * 20); // rough estimate
     for (uint16_t i = 0; i < n; ++i) {
-        const auto& p1 = input[i];
+        const int64_t x = xs[i], y = ys[i], z = zs[i];
         for (uint16_t j = i + 1; j < n; ++j) {
-            const auto& p2 = input[j];
-
-            uint64_t dx = static_cast<uint64_t>(p1.x - p2.x);
-            uint64_t dy = static_cast<uint64_t>(p1.y - p2.y);
-            uint64_t dz = static_cast<uint64_t>(p1.z - p2.z);
+            uint64_t dx = static_cast<uint64_t>(x - xs[j]);
+            uint64_t dy = static_cast<uint64_t>(y - ys[j]);
+            uint64_t dz = static_cast<uint64_t>(z - zs[j]);
 
             uint64_t d2 = dx*dx + dy*dy + dz*dz;
             if(d2 > limit) continue;
@@ -228,6 +245,58 @@ auto parse_input(std::string input_file = ""){
 }
 
 
+// Parsed input from the snapshot cache when it matches the input, otherwise parse and refresh the cache
+// Returned spans point into the snapshot mapping or into parsed, so both must outlive them
+auto load_input(const std::string& input_file, Snapshot::Reader& snapshot,
+                std::pair<std::vector<Point>, std::vector<PointPair>>& parsed){
+    using Spans = std::pair<std::span<const Point>, std::span<const PointPair>>;
+
+    // stdin can only be read once, so it is always parsed, as is everything with snapshots disabled
+    if(!Snapshot::enabled || (input_file.empty() && !InputUtils::embedded_source)){
+        parsed = parse_input(input_file);
+        return Spans{parsed.first, parsed.second};
+    }
+
+    std::string path = Snapshot::path_for(input_file, "day8");
+    uint64_t key = 0;
+    {
+        Timer::ScopedTimer t_("Snapshot Key");
+        InputUtils::InputSource source(input_file);
+        // Bump the tag whenever parse_input changes what it returns
+        key = Snapshot::input_key(source.view(), "day8-points-pairs-v1", SNAPSHOT_BUILD_ID);
+    }
+
+    if(snapshot.open(path, key)){
+        if(!InputUtils::quiet) std::println("Using snapshot: {}", path);
+        return Spans{snapshot.span<Point>(0), snapshot.span<PointPair>(1)};
+    }
+
+    parsed = parse_input(input_file);
+
+    Snapshot::Writer writer;
+    writer.add(parsed.first);
+    writer.add(parsed.second);
+    if(!writer.save(path, key)){
+        std::println(stderr, "Warning: Failed to write snapshot '{}'.", path);
+    }
+
+    return Spans{parsed.first, parsed.second};
+}
+
+// load_input together with the storage its spans point into, for the runner to keep between parts
+// Moving it keeps the spans valid, they point at the mapping or at vector heap buffers
+struct LoadedInput {
+    Snapshot::Reader snapshot;
+    std::pair<std::vector<Point>, std::vector<PointPair>> parsed;
+    std::pair<std::span<const Point>, std::span<const PointPair>> input;
+};
+
+auto load_owned_input(const std::string& input_file){
+    LoadedInput loaded;
+    loaded.input = load_input(input_file, loaded.snapshot, loaded.parsed);
+    return loaded;
+}
+
 
 auto p1(const auto& input_){
     Timer::ScopedTimer _t("Part 1");
@@ -332,13 +401,32 @@ auto p2(const auto& input_){
     return p2;
 }
 
+} // namespace day8
+
+#if USE_SNAPSHOT
+AOC_REGISTER_DAY(8, day8::load_owned_input,
+                 [](auto& loaded) { return day8::p1(loaded.input); },
+                 [](auto& loaded) { return day8::p2(loaded.input); });
+#else
+AOC_REGISTER_DAY(8, day8::parse_input, day8::p1, day8::p2);
+#endif
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day8;
     Timer::ScopedTimer t_("Total");
+#if USE_SNAPSHOT
+    Snapshot::Reader snapshot;
+    std::pair<std::vector<Point>, std::vector<PointPair>> parsed;
+    auto input = load_input((argc == 2 ? std::string(argv[1]) : ""), snapshot, parsed);
+#else
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
+#endif
 
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
 }
+#endif
 
 
 /*
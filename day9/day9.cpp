@@ -12,6 +12,7 @@
 #include <map>
 #include <compare>
 #include <limits>
+#include <array>
 
 #include <timer.h>
 
@@ -20,6 +21,9 @@
 #include <input.h>
 #include <string_utils.h>
 #include <grid.h>
+#include <solver.h>
+
+namespace day9 {
 
 struct Point {
     int64_t x;
@@ -34,31 +38,36 @@ struct PointHash {
     }
 };
 
+} // namespace day9
+
 template <>
-struct std::formatter<Point> {
+struct std::formatter<day9::Point> {
     constexpr auto parse(std::format_parse_context& ctx) {
         return ctx.begin();
     }
     template <typename FormatContext>
-    auto format(const Point& p, FormatContext& ctx) const {
+    auto format(const day9::Point& p, FormatContext& ctx) const {
         return std::format_to(ctx.out(), "Point(x={}, y={})", p.x, p.y);
     }
 };
 
 template <>
-struct std::formatter<std::vector<Point>> : std::range_formatter<Point> {
+struct std::formatter<std::vector<day9::Point>> : std::range_formatter<day9::Point> {
     constexpr formatter() {
         this->set_separator("\n");
         this->set_brackets("[", "]");
     }
 };
 
+namespace day9 {
+
 auto parse_input(std::string input_file = ""){
     Timer::ScopedTimer t_("Input Parsing");
 
     static auto parse_line = [](std::string_view line, std::vector<Point>& points) {
-        auto nums = StringUtils::extract_numbers<int64_t>(line);
-        if(nums.size() == 2){
+        // One spare slot so lines with too many numbers are still rejected
+        std::array<int64_t, 3> nums{};
+        if(StringUtils::extract_numbers(line, std::span(nums)) == 2){
             points.emplace_back(Point{static_cast<int>(nums[0]), static_cast<int>(nums[1])});
         }
     };
@@ -155,6 +164,8 @@ bool is_point_inside_polygon(double test_x, double test_y, const std::vector<Poi
 }
 
 bool is_valid_rectangle(const Point& bl, const Point& tr, const std::vector<Point>& points) {
+    PROFILE_SCOPE("is_valid_rectangle");
+
     // If a polygon vertex is strictly inside the rectangle
     for (const auto& p : points) {
         if (p.x > bl.x && p.x < tr.x && p.y > bl.y && p.y < tr.y) {
@@ -225,12 +236,19 @@ auto p2(const auto& input){
     return max_area;
 }
 
+} // namespace day9
+
+AOC_REGISTER_DAY(9, day9::parse_input, day9::p1, day9::p2);
+
+#ifndef AOC_RUNNER
 int main(int argc, char** argv){
+    using namespace day9;
     Timer::ScopedTimer t_("Total");
     auto input = parse_input((argc == 2 ? std::string(argv[1]) : ""));
     std::println("Part 1: {}", p1(input));
     std::println("Part 2: {}", p2(input));
 }
+#endif
 
 
 /*
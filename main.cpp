@@ -1,44 +1,161 @@
+// Defines the replacement operator new/delete when built with AOC_TRACK_ALLOCATIONS
+#define AOC_ALLOC_TRACKER_IMPL
 #include <iostream>
 #include <print>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <filesystem>
+#include <algorithm>
 
-#include <grid.h>
-#include <grid_graph.h>
+#include <timer.h>
+#include <solver.h>
+#include <string_utils.h>
 
-int main(int, char**){
-    std::cout << "Hello, from AOC2025!\n";
+// Runs any subset of the registered days in one process and prints a timing table
+//
+// Usage: AOC2025 [days...] [-j threads] [--inputs dir]
+//   days      Day numbers to run, all registered days if none are given
+//   -j        Run independent days concurrently on this many threads, default 1
+//   --inputs  Read dir/dayN/input.txt for every day instead of embedded input
+//
+// Days without embedded input always read inputs/dayN/input.txt (or dir/dayN/input.txt)
 
-    std::vector<std::string> raw_map = {
-        "S..#...",
-        ".#.#.#.",
-        ".......",
-        "######.",
-        "...E..."
-    };
+struct Options {
+    std::vector<int> days;
+    unsigned threads = 1;
+    std::optional<std::string> inputs;
+};
 
-    Grid::Grid<char> grid(raw_map, 1, '#'); 
+struct DayResult {
+    int number = 0;
+    double parse = 0.0;
+    double p1 = 0.0;
+    double p2 = 0.0;
+    std::string answer1;
+    std::string answer2;
+    std::string error;
 
-    size_t start = grid.find('S');
-    size_t end = grid.find('E');
+    double total() const { return parse + p1 + p2; }
+};
 
-    auto logic = [](Grid::Grid<char> grid, size_t from, size_t to) {
-        return grid[to] != '#';
+std::optional<Options> parse_args(int argc, char** argv){
+    auto usage = [&]{
+        std::println(stderr, "Usage: {} [days...] [-j threads] [--inputs dir]", argv[0]);
+        return std::nullopt;
     };
 
-    auto result = Grid::bfs_path(grid, start, end, logic);
+    Options options;
+    for(int i = 1; i < argc; i++){
+        std::string_view arg = argv[i];
+        if(arg == "-j" || arg == "--threads"){
+            auto threads = i + 1 < argc ? StringUtils::try_to_num<int>(argv[++i]) : std::nullopt;
+            if(!threads) return usage();
+            options.threads = std::max(1, *threads);
+        }else if(arg == "--inputs"){
+            if(i + 1 >= argc) return usage();
+            options.inputs = argv[++i];
+        }else if(auto day = StringUtils::try_to_num<int>(arg); day && arg.front() != '-'){
+            options.days.push_back(*day);
+        }else{
+            return usage();
+        }
+    }
+    return options;
+}
+
+DayResult run_day(const Solver::Day& day, const Options& options){
+    DayResult r;
+    r.number = day.number;
+
+    std::string path = Solver::input_path(day, options.inputs);
+    if(!path.empty() && !std::filesystem::exists(path)){
+        r.error = std::format("missing input '{}'", path);
+        return r;
+    }
+
+    try{
+        double start = Timer::now(Timer::TimerMode::Global);
+        Solver::Input input = day.parse(path);
+        double parsed = Timer::now(Timer::TimerMode::Global);
+        r.answer1 = day.p1(input);
+        double part1 = Timer::now(Timer::TimerMode::Global);
+        if(day.p2) r.answer2 = day.p2(input);
+        double part2 = Timer::now(Timer::TimerMode::Global);
+
+        r.parse = parsed - start;
+        r.p1 = part1 - parsed;
+        r.p2 = part2 - part1;
+    }catch(const std::exception& e){
+        r.error = e.what();
+    }
+    return r;
+}
 
-    if (result) {
-        std::println("Path found! Length: {}", result->size());
-        
-        // Visualize path
-        for (size_t idx : *result) {
-            if (grid[idx] != 'S' && grid[idx] != 'E') 
-                grid[idx] = '*';
+void print_table(const std::vector<DayResult>& results, double wall, unsigned threads){
+    std::println("{:>4} {:>12} {:>12} {:>12} {:>12}  {}", "Day", "Parse", "Part 1", "Part 2", "Total", "Answers");
+
+    double sum = 0.0;
+    for(const auto& r : results){
+        if(!r.error.empty()){
+            std::println("{:>4}  error: {}", r.number, r.error);
+            continue;
         }
-        grid.print();
-    } else {
-        std::println("No path found.");
+        sum += r.total();
+        std::string answers = r.answer2.empty() ? r.answer1 : std::format("{} / {}", r.answer1, r.answer2);
+        std::println("{:>4} {:>12} {:>12} {:>12} {:>12}  {}", r.number,
+                     Timer::formatTime(r.parse), Timer::formatTime(r.p1),
+                     r.answer2.empty() ? "-" : Timer::formatTime(r.p2),
+                     Timer::formatTime(r.total()), answers);
     }
+
+    std::println("Sum of days: {}", Timer::formatTime(sum));
+    std::println("Wall time:   {} ({} thread{})", Timer::formatTime(wall), threads, threads == 1 ? "" : "s");
+}
+
+int main(int argc, char** argv){
+    auto options = parse_args(argc, argv);
+    if(!options) return 1;
+
+    std::vector<Solver::Day> days;
+    for(const auto& day : Solver::days()){
+        if(options->days.empty() || std::ranges::contains(options->days, day.number)){
+            days.push_back(day);
+        }
+    }
+    for(int d : options->days){
+        if(!std::ranges::contains(days, d, &Solver::Day::number)){
+            std::println(stderr, "Warning: Day {} is not registered.", d);
+        }
+    }
+
+    // Per day output would interleave, the table replaces it
+    Solver::set_quiet(true);
+
+    std::vector<DayResult> results(days.size());
+    unsigned threads = std::min<unsigned>(options->threads, std::max<std::size_t>(days.size(), 1));
+
+    double start = Timer::now(Timer::TimerMode::Global);
+    {
+        // Each worker takes the next day until none are left
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]{
+            for(std::size_t i = next++; i < days.size(); i = next++){
+                results[i] = run_day(days[i], *options);
+            }
+        };
+
+        std::vector<std::jthread> pool;
+        for(unsigned t = 1; t < threads; t++) pool.emplace_back(worker);
+        worker();
+    }
+    double wall = Timer::now(Timer::TimerMode::Global) - start;
+
+    print_table(results, wall, threads);
+
+    return std::ranges::any_of(results, [](const auto& r){ return !r.error.empty(); }) ? 1 : 0;
 }
@@ -0,0 +1,82 @@
+#include <print>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <random>
+#include <cstdint>
+
+#include <cpu_dispatch.h>
+#include <string_utils.h>
+
+// Every digit_mask variant the host supports must match the scalar kernel, forced level by level,
+// on random bytes of every length up to a block and at every alignment, and extract_numbers built
+// on top of it must give the same numbers as at the scalar level
+
+// Bytes around the digit range and its unsigned wraparound, plus plain digits and separators
+std::string random_bytes(std::mt19937& rng, std::size_t n) {
+    static constexpr char pool_bytes[] = "0123456789/:-, \n\x00\x7f\x80\xaf\xb0\xb9\xff";
+    static constexpr std::string_view pool(pool_bytes, sizeof(pool_bytes) - 1);
+    std::uniform_int_distribution<std::size_t> pick(0, pool.size() - 1);
+    std::string s(n, ' ');
+    for (auto& c : s) c = pool[pick(rng)];
+    return s;
+}
+
+// Numbers with separators, lengths that are not a multiple of 16 or 32 and inputs ending in a digit
+std::vector<std::string> number_inputs(std::mt19937& rng) {
+    std::vector<std::string> inputs = {"", "7", "-7", "12,-34", "abc", "-", "1-2--3", std::string(64, '9'), std::string(65, '1')};
+    std::uniform_int_distribution<int> value(-100000, 100000);
+    for (std::size_t len : {15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 200, 1000}) {
+        std::string s;
+        while (s.size() < len) s += std::to_string(value(rng)) + (rng() % 2 ? "," : " ");
+        s.resize(len);
+        inputs.push_back(s);
+        // Same input ending in a digit
+        s.back() = '5';
+        inputs.push_back(s);
+    }
+    for (int i = 0; i < 200; ++i) inputs.push_back(random_bytes(rng, rng() % 300));
+    return inputs;
+}
+
+int main() {
+    using CpuDispatch::Level;
+    std::mt19937 rng(20);
+
+    // Room for every length at every offset within a 64 byte block
+    std::string bytes = random_bytes(rng, 4096);
+    auto inputs = number_inputs(rng);
+
+    std::vector<std::vector<std::int64_t>> expected;
+    {
+        CpuDispatch::ForceScope scalar(Level::Scalar);
+        for (const auto& s : inputs) expected.push_back(StringUtils::extract_numbers<std::int64_t>(s));
+    }
+
+    int failures = 0;
+    for (std::size_t l = 0; l <= static_cast<std::size_t>(CpuDispatch::supported()); ++l) {
+        auto level = static_cast<Level>(l);
+        CpuDispatch::ForceScope force(level);
+        auto kernel = StringUtils::detail::digit_mask.get(level);
+
+        for (std::size_t offset = 0; offset < 64; ++offset) {
+            for (std::size_t n = 0; n <= 64 && offset + n <= bytes.size(); ++n) {
+                const char* p = bytes.data() + offset;
+                if (kernel(p, n) != StringUtils::detail::digit_mask_scalar(p, n)) {
+                    std::println(stderr, "{}: digit_mask differs at offset {} length {}", CpuDispatch::name(level), offset, n);
+                    ++failures;
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            if (StringUtils::extract_numbers<std::int64_t>(inputs[i]) != expected[i]) {
+                std::println(stderr, "{}: extract_numbers differs on input {} of length {}", CpuDispatch::name(level), i, inputs[i].size());
+                ++failures;
+            }
+        }
+        std::println("{}: checked", CpuDispatch::name(level));
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+#include <print>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <map>
+#include <fstream>
+#include <filesystem>
+
+#include <input.h>
+#include <string_utils.h>
+
+// parse_input_parallel with OverwriteKeys must give what a serial parse gives
+// when a key is repeated across a chunk boundary, the later line wins
+
+using Map = std::map<std::string, std::vector<std::string>>;
+
+// "key: a b c" lines, a repeated key replaces its values like day11
+static auto parse_line = [](std::string_view line, Map& map) {
+    auto colon = line.find(':');
+    if(colon == std::string_view::npos) return;
+    auto& values = map[std::string(line.substr(0, colon))];
+    values.clear();
+    for(const auto v : StringUtils::split_view(line.substr(colon + 1), ' ')){
+        if(!v.empty()) values.emplace_back(v);
+    }
+};
+
+int main(){
+    // Large enough for two chunks, "dup" opens the first and closes the last
+    std::string text = "dup: first\n";
+    for(int i = 0; text.size() < 4 * InputUtils::parallel_min_chunk_size; ++i){
+        text += std::format("k{}: a{} b{}\n", i, i, i);
+    }
+    text += "dup: last\n";
+
+    auto path = (std::filesystem::temp_directory_path() / "aoc_parse_parallel.txt").string();
+    std::ofstream(path, std::ios::binary) << text;
+
+    auto chunks = InputUtils::split_chunks(text, 4);
+    if(chunks.size() < 2){
+        std::println(stderr, "Expected several chunks, got {}", chunks.size());
+        return 1;
+    }
+
+    auto serial = InputUtils::parse_input<Map>(parse_line, path);
+    auto parallel = InputUtils::parse_input_parallel<Map>(parse_line, path, InputUtils::OverwriteKeys{}, 4);
+    std::filesystem::remove(path);
+
+    if(parallel.at("dup") != std::vector<std::string>{"last"}){
+        std::println(stderr, "Repeated key kept '{}' instead of the later 'last'", parallel.at("dup").front());
+        return 1;
+    }
+    if(parallel != serial){
+        std::println(stderr, "Parallel parse differs from the serial parse");
+        return 1;
+    }
+    std::println("ok, {} keys over {} chunks", parallel.size(), chunks.size());
+}
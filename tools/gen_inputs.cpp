@@ -0,0 +1,450 @@
+#include <print>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <fstream>
+#include <filesystem>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+#include <set>
+
+#include <string_utils.h>
+
+// Seeded synthetic inputs for scaling benchmarks
+// Every generator writes a valid puzzle input, scale 1 is roughly the size of a real input
+// and the size grows linearly with scale (area for the grid days)
+//
+// Usage: gen_inputs <day|all> [--scale N] [--seed S] [--out path]
+//   day    2-12, or all to write path/dayN/input.txt for every day (path defaults to inputs_xN)
+//   scale  1 to 1000, default 1, day8 stops growing at 65 (65535 points, the most it can index)
+//   seed   Default 2025, the same seed and scale always give the same file
+//   out    File to write for a single day, stdout if omitted
+//
+// The generated directory can be passed to the runner and aoc_bench with --inputs
+// At large scales some answers wrap around in the days' unsigned totals, the timings are unaffected
+// day1 is not covered, it only reads its input at compile time
+
+using Rng = std::mt19937_64;
+
+int uniform(Rng& rng, int lo, int hi){
+    return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+int64_t uniform64(Rng& rng, int64_t lo, int64_t hi){
+    return std::uniform_int_distribution<int64_t>(lo, hi)(rng);
+}
+
+bool chance(Rng& rng, double p){
+    return std::bernoulli_distribution(p)(rng);
+}
+
+// Side length of a square grid whose area grows linearly with scale
+int scaled_side(int side, int scale){
+    return static_cast<int>(std::lround(side * std::sqrt(double(scale))));
+}
+
+// Product ID ranges on one line, "a-b,c-d,..."
+std::string gen_day2(Rng& rng, int scale){
+    int n = 35 * scale;
+    std::string out;
+    for(int i = 0; i < n; i++){
+        int64_t magnitude = int64_t{1} << uniform(rng, 3, 33);
+        int64_t from = uniform64(rng, magnitude, magnitude * 2);
+        int64_t to = from + uniform64(rng, 10, 100'000);
+        std::format_to(std::back_inserter(out), "{}{}-{}", i ? "," : "", from, to);
+    }
+    out += "\n";
+    return out;
+}
+
+// Banks of 100 battery joltages, digits 1-9
+std::string gen_day3(Rng& rng, int scale){
+    int n = 200 * scale;
+    std::string out;
+    for(int i = 0; i < n; i++){
+        for(int j = 0; j < 100; j++) out += char('0' + uniform(rng, 1, 9));
+        out += "\n";
+    }
+    return out;
+}
+
+// Grid of paper rolls '@' and empty '.'
+std::string gen_day4(Rng& rng, int scale){
+    int side = scaled_side(140, scale);
+    std::string out;
+    for(int r = 0; r < side; r++){
+        for(int c = 0; c < side; c++) out += chance(rng, 0.6) ? '@' : '.';
+        out += "\n";
+    }
+    return out;
+}
+
+// Fresh ingredient ID ranges, a blank line, then IDs to check
+std::string gen_day5(Rng& rng, int scale){
+    int ranges = 180 * scale;
+    int ids = 1000 * scale;
+    const int64_t MAX = 560'000'000'000'000;
+    std::string out;
+    for(int i = 0; i < ranges; i++){
+        int64_t from = uniform64(rng, 1, MAX);
+        int64_t to = from + uniform64(rng, 0, MAX / 500);
+        std::format_to(std::back_inserter(out), "{}-{}\n", from, to);
+    }
+    out += "\n";
+    for(int i = 0; i < ids; i++){
+        std::format_to(std::back_inserter(out), "{}\n", uniform64(rng, 1, MAX));
+    }
+    return out;
+}
+
+// Worksheet of problems side by side, four rows of numbers over a row of operators
+// Each problem is as wide as its longest number, the others are aligned left or right at random
+std::string gen_day6(Rng& rng, int scale){
+    constexpr int ROWS = 4;
+    int problems = 1000 * scale;
+    std::vector<std::string> lines(ROWS + 1);
+    for(int p = 0; p < problems; p++){
+        std::vector<std::string> nums;
+        std::size_t width = 0;
+        for(int r = 0; r < ROWS; r++){
+            nums.push_back(std::to_string(uniform(rng, 1, int(std::pow(10, uniform(rng, 1, 4))) - 1)));
+            width = std::max(width, nums.back().size());
+        }
+        bool left = chance(rng, 0.5);
+        for(int r = 0; r < ROWS; r++){
+            if(p) lines[r] += ' ';
+            std::string pad(width - nums[r].size(), ' ');
+            lines[r] += left ? nums[r] + pad : pad + nums[r];
+        }
+        if(p) lines[ROWS] += ' ';
+        lines[ROWS] += chance(rng, 0.5) ? '+' : '*';
+        lines[ROWS] += std::string(width - 1, ' ');
+    }
+
+    std::string out;
+    for(const auto& line : lines) out += line + "\n";
+    return out;
+}
+
+// Tachyon manifold, beams start at 'S' and split at '^' on every other row
+// Wider inputs get one independent source per 142 columns, the height stays fixed
+// because the number of timelines doubles with every row of splitters
+std::string gen_day7(Rng& rng, int scale){
+    constexpr int HEIGHT = 142;
+    constexpr int CELL = 142;
+    int width = CELL * scale - 1;
+    std::vector<std::string> grid(HEIGHT, std::string(width, '.'));
+
+    for(int s = 0; s < scale; s++){
+        int source = s * CELL + CELL / 2;
+        grid[0][source] = 'S';
+        // Splitters only where a beam from this source can reach, never on the edges
+        for(int r = 2; r < HEIGHT; r += 2){
+            int spread = r / 2;
+            for(int c = std::max(1, source - spread); c <= std::min(width - 2, source + spread); c++){
+                if((c - source + spread) % 2 == 0 && chance(rng, 0.6)) grid[r][c] = '^';
+            }
+        }
+    }
+
+    std::string out;
+    for(const auto& line : grid) out += line + "\n";
+    return out;
+}
+
+// Junction boxes "x,y,z"
+// day8 indexes points with uint16_t, so inputs are capped at 65535 points
+std::string gen_day8(Rng& rng, int scale){
+    int n = std::min(1000 * scale, 65535);
+    if(n < 1000 * scale){
+        std::println(stderr, "Warning: day8 is capped at {} points (scale 65), not the {} of scale {}, it indexes them with uint16_t.",
+                     n, 1000 * scale, scale);
+    }
+    std::string out;
+    for(int i = 0; i < n; i++){
+        std::format_to(std::back_inserter(out), "{},{},{}\n",
+                       uniform(rng, 0, 99999), uniform(rng, 0, 99999), uniform(rng, 0, 99999));
+    }
+    return out;
+}
+
+// Red tiles in order around a rectilinear polygon, consecutive tiles share a row or column
+// The polygon is a histogram: a skyline of columns with distinct x standing on y = 0
+std::string gen_day9(Rng& rng, int scale){
+    int columns = 248 * scale;
+    int x_max = static_cast<int>(100'000 * std::sqrt(double(scale)));
+
+    std::set<int> xs_set;
+    while(int(xs_set.size()) < columns + 1) xs_set.insert(uniform(rng, 0, x_max));
+    std::vector<int> xs(xs_set.begin(), xs_set.end());
+
+    std::vector<int> heights(columns);
+    for(int i = 0; i < columns; i++){
+        do{
+            heights[i] = uniform(rng, 1000, 100'000);
+        }while(i > 0 && heights[i] == heights[i - 1]);
+    }
+
+    std::string out;
+    std::format_to(std::back_inserter(out), "{},{}\n", xs[0], 0);
+    for(int i = 0; i < columns; i++){
+        std::format_to(std::back_inserter(out), "{},{}\n", xs[i], heights[i]);
+        std::format_to(std::back_inserter(out), "{},{}\n", xs[i + 1], heights[i]);
+    }
+    std::format_to(std::back_inserter(out), "{},{}\n", xs[columns], 0);
+    return out;
+}
+
+// Machines "[.##.] (3) (1,3) (2) {3,5,4,7}"
+// The target lights and joltages come from random button presses, so every machine is solvable
+std::string gen_day10(Rng& rng, int scale){
+    int n = 170 * scale;
+    std::string out;
+    for(int m = 0; m < n; m++){
+        int lights = uniform(rng, 4, 10);
+        int buttons = uniform(rng, lights - 1, lights + 3);
+
+        std::vector<std::vector<int>> wiring(buttons);
+        for(auto& b : wiring){
+            for(int l = 0; l < lights; l++) if(chance(rng, 0.4)) b.push_back(l);
+            if(b.empty()) b.push_back(uniform(rng, 0, lights - 1));
+        }
+        // Every light needs a button, or its joltage could never be reached
+        for(int l = 0; l < lights; l++){
+            auto covers = [l](const auto& b){ return std::ranges::contains(b, l); };
+            if(std::ranges::none_of(wiring, covers)){
+                auto& b = wiring[uniform(rng, 0, buttons - 1)];
+                b.insert(std::ranges::upper_bound(b, l), l);
+            }
+        }
+
+        std::vector<int> on(lights, 0), joltage(lights, 0);
+        for(const auto& b : wiring){
+            int presses = uniform(rng, 0, 40);
+            for(int l : b){
+                joltage[l] += presses;
+                on[l] ^= presses & 1;
+            }
+        }
+
+        out += "[";
+        for(int l : on) out += l ? '#' : '.';
+        out += "]";
+        for(const auto& b : wiring){
+            out += " (";
+            for(std::size_t i = 0; i < b.size(); i++) std::format_to(std::back_inserter(out), "{}{}", i ? "," : "", b[i]);
+            out += ")";
+        }
+        out += " {";
+        for(int l = 0; l < lights; l++) std::format_to(std::back_inserter(out), "{}{}", l ? "," : "", joltage[l]);
+        out += "}\n";
+    }
+    return out;
+}
+
+// Device graph "aaa: bbb ccc", a layered DAG ending in "out"
+// svr, fft and dac sit at increasing depths so routes through both waypoints exist
+// you sits a few layers from the end, day11's part 1 enumerates its paths one by one
+// More scale makes the layers wider, the depth (and so the path counts) stays the same
+std::string gen_day11(Rng& rng, int scale){
+    constexpr int LAYERS = 24;
+    int width = 25 * scale;
+
+    // Three letter names, longer once they run out
+    const std::set<std::string> reserved = {"you", "out", "svr", "fft", "dac"};
+    int next_name = 0;
+    auto name = [&]{
+        while(true){
+            std::string s;
+            int64_t v = next_name++;
+            int len = 3;
+            for(int64_t count = 26 * 26 * 26; v >= count; count *= 26, len++) v -= count;
+            for(int i = 0; i < len; i++){
+                s += char('a' + v % 26);
+                v /= 26;
+            }
+            if(!reserved.contains(s)) return s;
+        }
+    };
+
+    std::vector<std::vector<std::string>> layers(LAYERS);
+    for(auto& layer : layers){
+        for(int i = 0; i < width; i++) layer.push_back(name());
+    }
+    // A spine of one node per layer links the named nodes, so every route the puzzle asks about exists
+    std::vector<int> spine(LAYERS);
+    for(auto& s : spine) s = uniform(rng, 0, width - 1);
+    layers[0][spine[0]] = "svr";
+    layers[LAYERS / 3][spine[LAYERS / 3]] = "fft";
+    layers[2 * LAYERS / 3][spine[2 * LAYERS / 3]] = "dac";
+    layers[LAYERS - 6][spine[LAYERS - 6]] = "you";
+
+    std::string out;
+    for(int l = 0; l < LAYERS; l++){
+        for(int i = 0; i < width; i++){
+            const auto& node = layers[l][i];
+            out += node + ":";
+            if(l == LAYERS - 1){
+                out += " out\n";
+                continue;
+            }
+            // Mostly to the next layer, sometimes skipping one
+            int edges = uniform(rng, 1, 3);
+            std::set<std::string> targets;
+            if(i == spine[l]) targets.insert(layers[l + 1][spine[l + 1]]);
+            for(int e = 0; e < edges; e++){
+                int to = std::min(LAYERS - 1, l + (chance(rng, 0.8) ? 1 : 2));
+                targets.insert(layers[to][uniform(rng, 0, width - 1)]);
+            }
+            for(const auto& t : targets) out += " " + t;
+            out += "\n";
+        }
+    }
+    return out;
+}
+
+// Six 3x3 presents, then regions "WxH: c0 c1 c2 c3 c4 c5"
+// Regions either fit every present in its own 3x3 cell or have less area than the presents,
+// the two cases day12 decides without searching
+std::string gen_day12(Rng& rng, int scale){
+    constexpr int SHAPES = 6;
+    std::string out;
+    std::vector<int> areas;
+    for(int s = 0; s < SHAPES; s++){
+        std::vector<std::string> shape(3, "...");
+        int area = 0;
+        // Keep the centre filled so every shape is one piece, and at least five cells
+        while(area < 5){
+            shape = {"...", ".#.", "..."};
+            area = 1;
+            for(int r = 0; r < 3; r++){
+                for(int c = 0; c < 3; c++){
+                    if((r != 1 || c != 1) && chance(rng, 0.7)){
+                        shape[r][c] = '#';
+                        area++;
+                    }
+                }
+            }
+        }
+        areas.push_back(area);
+        std::format_to(std::back_inserter(out), "{}:\n{}\n{}\n{}\n\n", s, shape[0], shape[1], shape[2]);
+    }
+
+    int regions = 1000 * scale;
+    for(int i = 0; i < regions; i++){
+        int w = uniform(rng, 35, 50), h = uniform(rng, 35, 50);
+        std::vector<int> counts(SHAPES, 0);
+        if(chance(rng, 0.5)){
+            int cells = (w / 3) * (h / 3) - uniform(rng, 0, 10);
+            for(int k = 0; k < cells; k++) counts[uniform(rng, 0, SHAPES - 1)]++;
+        }else{
+            int area = 0;
+            while(area <= w * h){
+                int s = uniform(rng, 0, SHAPES - 1);
+                counts[s]++;
+                area += areas[s];
+            }
+            // A little over, not far past what a real input would ask for
+            for(int k = 0; k < uniform(rng, 0, 3); k++){
+                counts[uniform(rng, 0, SHAPES - 1)]++;
+            }
+        }
+        std::format_to(std::back_inserter(out), "{}x{}:", w, h);
+        for(int c : counts) std::format_to(std::back_inserter(out), " {}", c);
+        out += "\n";
+    }
+    return out;
+}
+
+using Generator = std::function<std::string(Rng&, int)>;
+
+const std::vector<std::pair<int, Generator>>& generators(){
+    static const std::vector<std::pair<int, Generator>> g = {
+        {2, gen_day2}, {3, gen_day3}, {4, gen_day4}, {5, gen_day5}, {6, gen_day6}, {7, gen_day7},
+        {8, gen_day8}, {9, gen_day9}, {10, gen_day10}, {11, gen_day11}, {12, gen_day12},
+    };
+    return g;
+}
+
+bool write_file(const std::filesystem::path& path, const std::string& content){
+    if(path.has_parent_path()) std::filesystem::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+    if(!out){
+        std::println(stderr, "Error: Failed to write '{}'.", path.string());
+        return false;
+    }
+    std::println(stderr, "Wrote {} ({} bytes)", path.string(), content.size());
+    return true;
+}
+
+int main(int argc, char** argv){
+    auto usage = [&]{
+        std::println(stderr, "Usage: {} <day|all> [--scale N] [--seed S] [--out path]", argv[0]);
+        std::println(stderr, "  N is 1 to 1000, day8 is capped at 65535 points so it stops scaling above 65");
+        return 1;
+    };
+    if(argc < 2) return usage();
+
+    std::string_view which = argv[1];
+    int scale = 1;
+    uint64_t seed = 2025;
+    std::string out;
+    for(int i = 2; i < argc; i++){
+        std::string_view arg = argv[i];
+        if(i + 1 >= argc) return usage();
+        std::string_view value = argv[++i];
+        if(arg == "--scale"){
+            auto s = StringUtils::try_to_num<int>(value);
+            if(!s || *s < 1) return usage();
+            scale = *s;
+        }else if(arg == "--seed"){
+            auto s = StringUtils::try_to_num<uint64_t>(value);
+            if(!s) return usage();
+            seed = *s;
+        }else if(arg == "--out"){
+            out = value;
+        }else{
+            return usage();
+        }
+    }
+    if(scale > 1000){
+        std::println(stderr, "Error: Scale must be between 1 and 1000.");
+        return 1;
+    }
+
+    // Each day draws from its own stream, so adding a day never changes another day's input
+    auto generate = [&](int day, const Generator& gen){
+        Rng rng(seed * 1000 + day);
+        return gen(rng, scale);
+    };
+
+    if(which == "all"){
+        std::filesystem::path dir = out.empty() ? std::format("inputs_x{}", scale) : out;
+        for(const auto& [day, gen] : generators()){
+            if(!write_file(dir / std::format("day{}", day) / "input.txt", generate(day, gen))) return 1;
+        }
+        return 0;
+    }
+
+    auto parsed_day = StringUtils::try_to_num<int>(which);
+    if(!parsed_day) return usage();
+    int day = *parsed_day;
+    auto it = std::ranges::find(generators(), day, [](const auto& g){ return g.first; });
+    if(it == generators().end()){
+        std::println(stderr, "Error: No generator for day {}.", day);
+        return 1;
+    }
+
+    std::string content = generate(day, it->second);
+    if(out.empty()){
+        std::fwrite(content.data(), 1, content.size(), stdout);
+        return 0;
+    }
+    return write_file(out, content) ? 0 : 1;
+}
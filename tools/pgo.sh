@@ -0,0 +1,141 @@
+#!/usr/bin/env bash
+# Profile guided, link time optimised build with a per day speedup report
+#
+# Usage: tools/pgo.sh [days...] [--build dir] [--baseline-build dir] [--scale N] [--time seconds]
+#   days              Days to measure, all registered days if none are given
+#   --build           Build directory of both PGO stages, default build-pgo
+#   --baseline-build  Plain Release build to compare against, default build-release
+#   --scale           Scale of the generated inputs used for training on top of the real ones, default 4
+#   --time            Seconds of measured runs per phase, default 0.5
+#
+# Stage 1 configures the build with AOC_PGO=generate and trains it by running the runner,
+# aoc_bench and every standalone day on the embedded inputs and on gen_inputs output
+# Stage 2 rebuilds the same directory with AOC_PGO=use (and LTO), then aoc_bench times both
+# builds and the medians are compared phase by phase
+#
+# Extra CMake arguments for both builds can be passed in CMAKE_ARGS, e.g. CMAKE_ARGS="-G Ninja"
+set -euo pipefail
+
+root=$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)
+build=build-pgo
+baseline_build=build-release
+scale=4
+time=0.5
+days=()
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --build) build=$2; shift 2 ;;
+        --baseline-build) baseline_build=$2; shift 2 ;;
+        --scale) scale=$2; shift 2 ;;
+        --time) time=$2; shift 2 ;;
+        [0-9]*) days+=("$1"); shift ;;
+        *) echo "Usage: $0 [days...] [--build dir] [--baseline-build dir] [--scale N] [--time seconds]" >&2; exit 2 ;;
+    esac
+done
+
+build=$(mkdir -p "$build" && cd "$build" && pwd)
+baseline_build=$(mkdir -p "$baseline_build" && cd "$baseline_build" && pwd)
+profiles="$build/pgo"
+jobs=$(nproc 2>/dev/null || echo 4)
+read -r -a cmake_args <<< "${CMAKE_ARGS:-}"
+
+step() { echo; echo "==> $*"; }
+
+# Stage 1, instrumented build and training runs
+step "Instrumented build in $build"
+rm -rf "$profiles"
+cmake -S "$root" -B "$build" ${cmake_args[@]+"${cmake_args[@]}"} -DCMAKE_BUILD_TYPE=Release -DAOC_PGO=generate -DAOC_PGO_DIR="$profiles"
+cmake --build "$build" -j "$jobs" --clean-first
+
+step "Training"
+generated="$build/inputs_x$scale"
+"$build/tools/gen_inputs" all --scale "$scale" --out "$generated"
+# A failed training run leaves that code without a profile, so it stops the script
+# stdin is closed everywhere, days without embedded input would otherwise wait on the terminal
+(
+    cd "$build"
+    ./AOC2025 < /dev/null > /dev/null
+    ./AOC2025 --inputs "$generated" < /dev/null > /dev/null
+    ./bench/aoc_bench --update --time 0.05 --baseline "$profiles/training.jsonl" < /dev/null > /dev/null
+    ./bench/aoc_bench --update --time 0.05 --inputs "$generated" --baseline "$profiles/training_x$scale.jsonl" < /dev/null > /dev/null
+)
+for dir in "$build"/day*/; do
+    day=$(basename "$dir")
+    [[ -x "$dir/$day" ]] || continue
+    input="$build/inputs/$day/input.txt"
+    if [[ ! -f "$input" ]]; then
+        echo "error: missing training input $input" >&2
+        exit 1
+    fi
+    if ! (cd "$dir" && "./$day" "../inputs/$day/input.txt" < /dev/null > /dev/null); then
+        echo "error: $day failed during training" >&2
+        exit 1
+    fi
+done
+
+# Clang writes raw profiles that have to be merged first, GCC reads its .gcda files directly
+shopt -s nullglob
+raw=("$profiles"/*.profraw)
+shopt -u nullglob
+if [[ ${#raw[@]} -gt 0 ]]; then
+    llvm-profdata merge -output="$profiles/default.profdata" "${raw[@]}"
+fi
+
+# Stage 2, optimised with the profile
+step "Profile guided build in $build"
+cmake -S "$root" -B "$build" ${cmake_args[@]+"${cmake_args[@]}"} -DAOC_PGO=use
+cmake --build "$build" -j "$jobs" --clean-first
+
+step "Baseline build in $baseline_build"
+cmake -S "$root" -B "$baseline_build" ${cmake_args[@]+"${cmake_args[@]}"} -DCMAKE_BUILD_TYPE=Release -DAOC_PGO= -DAOC_LTO=OFF
+cmake --build "$baseline_build" -j "$jobs" --target aoc_bench
+
+# Measure, aoc_bench --update into fresh files gives one JSON line of medians per phase
+step "Measuring"
+rm -f "$baseline_build/pgo_compare.jsonl" "$build/pgo_compare.jsonl"
+(cd "$baseline_build" && ./bench/aoc_bench ${days[@]+"${days[@]}"} --update --time "$time" --baseline pgo_compare.jsonl > /dev/null)
+(cd "$build" && ./bench/aoc_bench ${days[@]+"${days[@]}"} --update --time "$time" --baseline pgo_compare.jsonl > /dev/null)
+
+step "Speedup, Release vs PGO + LTO (medians)"
+awk '
+    function field(line, key,    m) {
+        if (match(line, "\"" key "\":\"?[^,\"}]*")) {
+            m = substr(line, RSTART, RLENGTH)
+            sub("\"" key "\":\"?", "", m)
+            return m
+        }
+        return ""
+    }
+    function fmt(s) {
+        if (s >= 1) return sprintf("%.3f s", s)
+        if (s >= 1e-3) return sprintf("%.3f ms", s * 1e3)
+        return sprintf("%.3f us", s * 1e6)
+    }
+    FNR == 1 { file++ }
+    {
+        name = field($0, "name"); median = field($0, "median") + 0
+        if (name == "") next
+        if (file == 1) { base[name] = median; order[++n] = name }
+        else pgo[name] = median
+    }
+    END {
+        printf "%-12s %12s %12s %9s\n", "Phase", "Release", "PGO+LTO", "Speedup"
+        for (i = 1; i <= n; i++) {
+            name = order[i]
+            if (!(name in pgo)) continue
+            day = name; sub("/.*", "", day)
+            day_base[day] += base[name]; day_pgo[day] += pgo[name]
+            if (!(day in seen)) { seen[day] = 1; days[++d] = day }
+            printf "%-12s %12s %12s %8.2fx\n", name, fmt(base[name]), fmt(pgo[name]), (pgo[name] > 0 ? base[name] / pgo[name] : 0)
+        }
+        print ""
+        printf "%-12s %12s %12s %9s\n", "Day", "Release", "PGO+LTO", "Speedup"
+        for (i = 1; i <= d; i++) {
+            day = days[i]
+            total_base += day_base[day]; total_pgo += day_pgo[day]
+            printf "%-12s %12s %12s %8.2fx\n", day, fmt(day_base[day]), fmt(day_pgo[day]), (day_pgo[day] > 0 ? day_base[day] / day_pgo[day] : 0)
+        }
+        printf "%-12s %12s %12s %8.2fx\n", "all", fmt(total_base), fmt(total_pgo), (total_pgo > 0 ? total_base / total_pgo : 0)
+    }
+' "$baseline_build/pgo_compare.jsonl" "$build/pgo_compare.jsonl"
@@ -0,0 +1,194 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+// Heap allocation accounting, opt in with AOC_TRACK_ALLOCATIONS
+// Replaces the global operator new/delete to count allocations, bytes and peak live bytes,
+// both for the whole process and for the innermost active Scope of the calling thread
+// (every ScopedTimer opens one), so each timer can report what its code allocated
+//
+// The replacement operators must be defined in exactly one translation unit
+// Standalone days get them from their single TU, programs linking several days
+// (the runner, aoc_bench) define AOC_ALLOC_TRACKER_IMPL in the TU holding main
+namespace AllocTracker {
+
+    struct Counters {
+        std::uint64_t allocations = 0;
+        std::uint64_t frees = 0;
+        std::uint64_t bytes = 0;      // Total requested
+        std::int64_t live = 0;        // Can go negative in a scope that frees memory from outside it
+        std::int64_t peak = 0;        // Highest live
+    };
+
+    // Counters of one scope, linked to the enclosing scope of the same thread
+    // Threads started inside a scope are not attributed to it, they only count towards the totals
+    class Scope {
+    public:
+        Scope() : parent(current()) { current() = this; }
+
+        ~Scope() {
+            current() = parent;
+            if (!parent) return;
+            // Children are inclusive, their peak sits on top of whatever the parent had live
+            parent->counters.allocations += counters.allocations;
+            parent->counters.frees += counters.frees;
+            parent->counters.bytes += counters.bytes;
+            parent->counters.peak = std::max(parent->counters.peak, parent->counters.live + counters.peak);
+            parent->counters.live += counters.live;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        const Counters& get() const { return counters; }
+
+        // Innermost scope of the calling thread, nullptr outside any
+        static Scope*& current() {
+            thread_local Scope* scope = nullptr;
+            return scope;
+        }
+
+        void on_alloc(std::size_t size) {
+            counters.allocations++;
+            counters.bytes += size;
+            counters.live += static_cast<std::int64_t>(size);
+            counters.peak = std::max(counters.peak, counters.live);
+        }
+
+        void on_free(std::size_t size) {
+            counters.frees++;
+            counters.live -= static_cast<std::int64_t>(size);
+        }
+
+    private:
+        Scope* parent;
+        Counters counters;
+    };
+
+    struct Totals {
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> frees{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::int64_t> live{0};
+        std::atomic<std::int64_t> peak{0};
+    };
+
+    // Whole process, every thread
+    inline Totals& totals() {
+        static Totals t;
+        return t;
+    }
+
+    inline void record_alloc(std::size_t size) {
+        auto& t = totals();
+        t.allocations.fetch_add(1, std::memory_order_relaxed);
+        t.bytes.fetch_add(size, std::memory_order_relaxed);
+        std::int64_t live = t.live.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed) + static_cast<std::int64_t>(size);
+        std::int64_t peak = t.peak.load(std::memory_order_relaxed);
+        while (live > peak && !t.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+        if (Scope* s = Scope::current()) s->on_alloc(size);
+    }
+
+    inline void record_free(std::size_t size) {
+        auto& t = totals();
+        t.frees.fetch_add(1, std::memory_order_relaxed);
+        t.live.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+
+        if (Scope* s = Scope::current()) s->on_free(size);
+    }
+
+    inline std::string format_bytes(double bytes) {
+        const char* units[] = {"B", "KiB", "MiB", "GiB"};
+        int u = 0;
+        while (std::abs(bytes) >= 1024.0 && u < 3) {
+            bytes /= 1024.0;
+            u++;
+        }
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(u == 0 ? 0 : 1) << bytes << " " << units[u];
+        return oss.str();
+    }
+
+    inline std::string format(const Counters& c) {
+        std::ostringstream oss;
+        oss << c.allocations << " allocs, " << format_bytes(double(c.bytes))
+            << ", peak " << format_bytes(double(c.peak));
+        return oss.str();
+    }
+
+    // Every block carries its size and the distance back to the start of the raw allocation
+    // in the 16 bytes before the pointer handed out, so all delete forms can find both
+    namespace detail {
+        inline constexpr std::size_t HEADER = 2 * sizeof(std::size_t);
+        static_assert(HEADER >= alignof(std::max_align_t));
+
+        inline void* allocate(std::size_t size, std::size_t alignment) {
+            std::size_t offset = std::max(alignment, HEADER);
+            std::size_t total = size + offset;
+            void* raw = alignment > HEADER
+                ? std::aligned_alloc(offset, (total + offset - 1) / offset * offset)
+                : std::malloc(total);
+            if (!raw) return nullptr;
+
+            auto* user = static_cast<std::byte*>(raw) + offset;
+            reinterpret_cast<std::size_t*>(user)[-2] = size;
+            reinterpret_cast<std::size_t*>(user)[-1] = offset;
+            record_alloc(size);
+            return user;
+        }
+
+        inline void deallocate(void* p) noexcept {
+            if (!p) return;
+            auto* user = static_cast<std::byte*>(p);
+            std::size_t size = reinterpret_cast<std::size_t*>(user)[-2];
+            std::size_t offset = reinterpret_cast<std::size_t*>(user)[-1];
+            record_free(size);
+            std::free(user - offset);
+        }
+
+        inline void* allocate_or_throw(std::size_t size, std::size_t alignment) {
+            // operator new has to keep calling the new handler until it gives up
+            while (true) {
+                if (void* p = allocate(size, alignment)) return p;
+                auto handler = std::get_new_handler();
+                if (!handler) throw std::bad_alloc();
+                handler();
+            }
+        }
+    }
+}
+
+#if defined(AOC_TRACK_ALLOCATIONS) && (!defined(AOC_RUNNER) || defined(AOC_ALLOC_TRACKER_IMPL))
+
+void* operator new(std::size_t size) { return AllocTracker::detail::allocate_or_throw(size, 0); }
+void* operator new[](std::size_t size) { return AllocTracker::detail::allocate_or_throw(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al) { return AllocTracker::detail::allocate_or_throw(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return AllocTracker::detail::allocate_or_throw(size, static_cast<std::size_t>(al)); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return AllocTracker::detail::allocate(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return AllocTracker::detail::allocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return AllocTracker::detail::allocate(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return AllocTracker::detail::allocate(size, static_cast<std::size_t>(al)); }
+
+void operator delete(void* p) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete[](void* p) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete(void* p, std::align_val_t) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { AllocTracker::detail::deallocate(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { AllocTracker::detail::deallocate(p); }
+
+#endif
@@ -0,0 +1,188 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <optional>
+#include <algorithm>
+#include <string_view>
+#include <cstdlib>
+#include <cctype>
+#include <iostream>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define CPU_DISPATCH_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#else
+    #define CPU_DISPATCH_X86 0
+#endif
+
+// Runtime selection between ISA specific variants of a kernel
+// One portable binary (built for baseline x86-64) still uses AVX2 / AVX-512 on hosts that have them
+//
+// Variants are ordinary functions compiled for their level with the AOC_TARGET_* attributes,
+// so intrinsics of that level can be used without raising the flags of the whole build
+// Kernel holds one pointer per level and calls the best one the host supports
+//
+// The level is detected once, on first use, and can be forced (never above what the host supports)
+//   AOC_FORCE_ISA=scalar|sse42|avx2|avx512 in the environment, or CpuDispatch::force(level)
+namespace CpuDispatch {
+
+    enum class Level { Scalar, SSE42, AVX2, AVX512 };
+
+    inline constexpr std::size_t LEVELS = 4;
+
+    inline constexpr std::string_view name(Level level) {
+        switch (level) {
+            case Level::Scalar: return "scalar";
+            case Level::SSE42:  return "sse42";
+            case Level::AVX2:   return "avx2";
+            case Level::AVX512: return "avx512";
+        }
+        return "unknown";
+    }
+
+// Only GCC and Clang need the attributes, MSVC lets any function use any intrinsic
+#if CPU_DISPATCH_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define AOC_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+    #define AOC_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+    #define AOC_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")))
+#else
+    #define AOC_TARGET_SSE42
+    #define AOC_TARGET_AVX2
+    #define AOC_TARGET_AVX512
+#endif
+
+    namespace detail {
+        // Highest level both the CPU and the OS (saved vector registers) support
+        inline Level detect() {
+        #if CPU_DISPATCH_X86 && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("bmi2")) return Level::AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2")) return Level::AVX2;
+            if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) return Level::SSE42;
+            return Level::Scalar;
+        #elif CPU_DISPATCH_X86 && defined(_MSC_VER)
+            int regs[4];
+            __cpuid(regs, 0);
+            int max_leaf = regs[0];
+            __cpuid(regs, 1);
+            bool sse42 = (regs[2] & (1 << 20)) && (regs[2] & (1 << 23));
+            bool osxsave = regs[2] & (1 << 27);
+            if (!sse42) return Level::Scalar;
+            if (!osxsave || max_leaf < 7) return Level::SSE42;
+
+            unsigned long long xcr0 = _xgetbv(0);
+            __cpuidex(regs, 7, 0);
+            bool avx2 = (regs[1] & (1 << 5)) && (regs[1] & (1 << 8)) && (xcr0 & 0x6) == 0x6;
+            bool avx512 = (regs[1] & (1 << 16)) && (regs[1] & (1 << 30)) && (regs[1] & (1 << 31)) && (xcr0 & 0xe6) == 0xe6;
+            if (avx2 && avx512) return Level::AVX512;
+            if (avx2) return Level::AVX2;
+            return Level::SSE42;
+        #else
+            return Level::Scalar;
+        #endif
+        }
+
+        inline std::optional<Level> parse(std::string_view s) {
+            for (std::size_t i = 0; i < LEVELS; ++i) {
+                auto level = static_cast<Level>(i);
+                auto n = name(level);
+                if (s.size() == n.size() && std::equal(s.begin(), s.end(), n.begin(),
+                        [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; })) {
+                    return level;
+                }
+            }
+            return std::nullopt;
+        }
+
+        inline Level clamp(Level requested, Level supported) {
+            if (requested <= supported) return requested;
+            std::cerr << "[CpuDispatch] " << name(requested) << " is not supported by this CPU, using " << name(supported) << "\n";
+            return supported;
+        }
+
+        // Detected level, lowered by AOC_FORCE_ISA
+        inline Level initial() {
+            Level level = detect();
+            if (const char* env = std::getenv("AOC_FORCE_ISA"); env && *env) {
+                if (auto forced = parse(env)) {
+                    level = clamp(*forced, level);
+                } else {
+                    std::cerr << "[CpuDispatch] Unknown AOC_FORCE_ISA '" << env << "', expected scalar, sse42, avx2 or avx512\n";
+                }
+            }
+            return level;
+        }
+
+        inline std::atomic<Level>& active() {
+            static std::atomic<Level> level{initial()};
+            return level;
+        }
+    }
+
+    // What the host supports, ignoring any forced level
+    inline Level supported() {
+        static const Level level = detail::detect();
+        return level;
+    }
+
+    // Level kernels currently run at
+    inline Level level() {
+        return detail::active().load(std::memory_order_relaxed);
+    }
+
+    // Run every kernel at this level from now on, lowered to what the host supports
+    inline void force(Level requested) {
+        detail::active().store(detail::clamp(requested, supported()), std::memory_order_relaxed);
+    }
+
+    // Back to the detected (or AOC_FORCE_ISA) level
+    inline void reset() {
+        detail::active().store(detail::initial(), std::memory_order_relaxed);
+    }
+
+    // Forces a level for the lifetime of the object, for benchmarking one variant against another
+    class ForceScope {
+    public:
+        explicit ForceScope(Level requested) : previous(level()) { force(requested); }
+        ~ForceScope() { detail::active().store(previous, std::memory_order_relaxed); }
+
+        ForceScope(const ForceScope&) = delete;
+        ForceScope& operator=(const ForceScope&) = delete;
+
+    private:
+        Level previous;
+    };
+
+    // One function pointer per level, scalar is required and missing levels fall back to the next one down
+    // Calls cost an indirect call plus a relaxed load, so dispatch whole blocks of work, not single elements
+    template <typename Fn>
+    class Kernel;
+
+    template <typename R, typename... Args>
+    class Kernel<R(Args...)> {
+    public:
+        using Fn = R (*)(Args...);
+
+        constexpr Kernel(Fn scalar, Fn sse42 = nullptr, Fn avx2 = nullptr, Fn avx512 = nullptr)
+            : variants{scalar, sse42, avx2, avx512} {}
+
+        R operator()(Args... args) const { return get()(std::forward<Args>(args)...); }
+
+        // Variant that runs at the current level
+        Fn get() const { return get(level()); }
+
+        Fn get(Level l) const {
+            for (std::size_t i = static_cast<std::size_t>(l); i > 0; --i) {
+                if (variants[i]) return variants[i];
+            }
+            return variants[0];
+        }
+
+    private:
+        std::array<Fn, LEVELS> variants;
+    };
+}
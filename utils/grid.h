@@ -8,10 +8,159 @@
 #include <ranges>
 #include <algorithm>
 #include <numeric>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <span>
+#include <cassert>
 
 namespace Grid{
 
-template<typename T>
+// Storage layouts for Grid
+// A layout maps padded coordinates (r, c), with 0 <= r < rows and 0 <= c < cols of the padded grid,
+// to a position in the data vector and back, and steps from a position to its neighbours
+//   RowMajor  Plain rows, neighbours are fixed offsets (offsets_4 / offsets_8)
+//   Tiled8    8x8 tiles of 64 cells stored one after another, row-major inside and between tiles
+//   Morton    Z-order, bits of row and column interleaved, each dimension padded to a power of two (up to 4x the cells)
+// Vertical and 2D-local walks (BFS, flood fills, column sweeps) stay within a few cache lines and
+// pages with Tiled8 and Morton, where RowMajor touches a new line every row
+
+struct RowMajor {
+    static constexpr bool linear = true;  // Neighbours are at constant offsets
+
+    std::size_t width = 0;
+    std::size_t cells = 0;
+
+    RowMajor() = default;
+    constexpr RowMajor(std::size_t rows, std::size_t cols) : width(cols), cells(rows * cols) {}
+
+    constexpr std::size_t size() const { return cells; }
+    constexpr std::size_t index(std::size_t r, std::size_t c) const { return r * width + c; }
+    constexpr std::pair<std::size_t, std::size_t> coord(std::size_t idx) const { return {idx / width, idx % width}; }
+    constexpr std::size_t step(std::size_t idx, int dy, int dx) const {
+        return idx + static_cast<std::ptrdiff_t>(dy) * static_cast<std::ptrdiff_t>(width) + dx;
+    }
+};
+
+struct Tiled8 {
+    static constexpr bool linear = false;
+
+    std::size_t tiles_x = 0;  // Tiles per row of tiles
+    std::size_t cells = 0;
+
+    Tiled8() = default;
+    constexpr Tiled8(std::size_t rows, std::size_t cols)
+        : tiles_x((cols + 7) / 8), cells((rows + 7) / 8 * tiles_x * 64) {}
+
+    constexpr std::size_t size() const { return cells; }
+
+    constexpr std::size_t index(std::size_t r, std::size_t c) const {
+        return ((r >> 3) * tiles_x + (c >> 3)) * 64 + ((r & 7) << 3) + (c & 7);
+    }
+
+    constexpr std::pair<std::size_t, std::size_t> coord(std::size_t idx) const {
+        std::size_t tile = idx >> 6;
+        return {(tile / tiles_x) * 8 + ((idx >> 3) & 7), (tile % tiles_x) * 8 + (idx & 7)};
+    }
+
+    // Moves inside the tile are a plain offset, crossing into another tile moves the tile index
+    constexpr std::size_t step(std::size_t idx, int dy, int dx) const {
+        int r = static_cast<int>((idx >> 3) & 7) + dy;
+        int c = static_cast<int>(idx & 7) + dx;
+        if (static_cast<unsigned>(r) < 8 && static_cast<unsigned>(c) < 8) return idx + dy * 8 + dx;
+
+        // Floor division by 8, also for negative values
+        std::ptrdiff_t tile = static_cast<std::ptrdiff_t>(idx >> 6)
+                            + static_cast<std::ptrdiff_t>(r >> 3) * static_cast<std::ptrdiff_t>(tiles_x) + (c >> 3);
+        return static_cast<std::size_t>(tile) * 64 + static_cast<std::size_t>(((r & 7) << 3) | (c & 7));
+    }
+};
+
+struct Morton {
+    static constexpr bool linear = false;
+
+    // Each dimension is rounded up to a power of two on its own, 2^row_bits x 2^col_bits cells
+    // The low shared bits of row and column are interleaved, columns on the even bits and rows on the odd ones,
+    // and the longer dimension's remaining bits sit above them, so a 1 x N grid costs N cells, not N^2
+    std::size_t shared = 0;       // Interleaved bits of each coordinate, min(row_bits, col_bits)
+    bool rows_longer = false;     // Which coordinate owns the bits above 2 * shared
+    std::uint64_t col_mask = 0;   // Bits of an index holding the column
+    std::uint64_t row_mask = 0;   // Everything else
+    std::size_t cells = 0;
+
+    Morton() = default;
+    constexpr Morton(std::size_t rows, std::size_t cols) {
+        std::size_t row_bits = std::bit_width(std::bit_ceil(std::max(rows, std::size_t{1}))) - 1;
+        std::size_t col_bits = std::bit_width(std::bit_ceil(std::max(cols, std::size_t{1}))) - 1;
+        shared = std::min(row_bits, col_bits);
+        rows_longer = row_bits > col_bits;
+        std::uint64_t low = shared ? ~0ull >> (64 - 2 * shared) : 0;
+        col_mask = (0x5555555555555555ull & low) | (rows_longer ? 0 : ~low);
+        row_mask = ~col_mask;
+        cells = std::size_t{1} << (row_bits + col_bits);
+    }
+
+    constexpr std::size_t size() const { return cells; }
+
+    // Low 32 bits of v moved to the even bit positions
+    static constexpr std::uint64_t spread(std::uint64_t v) {
+        v &= 0xFFFFFFFFull;
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v << 2)) & 0x3333333333333333ull;
+        v = (v | (v << 1)) & 0x5555555555555555ull;
+        return v;
+    }
+
+    // Inverse of spread, the even bits of v packed together
+    static constexpr std::uint64_t compact(std::uint64_t v) {
+        v &= 0x5555555555555555ull;
+        v = (v | (v >> 1)) & 0x3333333333333333ull;
+        v = (v | (v >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v >> 4)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v >> 8)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v >> 16)) & 0x00000000FFFFFFFFull;
+        return v;
+    }
+
+    // Only the longer coordinate has bits above shared
+    constexpr std::size_t index(std::size_t r, std::size_t c) const {
+        std::uint64_t low = (std::uint64_t{1} << shared) - 1;
+        std::uint64_t high = (rows_longer ? r : c) >> shared;
+        return static_cast<std::size_t>(spread(c & low) | (spread(r & low) << 1) | (high << (2 * shared)));
+    }
+
+    constexpr std::pair<std::size_t, std::size_t> coord(std::size_t idx) const {
+        std::uint64_t low = shared ? idx & (~0ull >> (64 - 2 * shared)) : 0;
+        std::uint64_t high = static_cast<std::uint64_t>(idx) >> (2 * shared) << shared;
+        std::uint64_t r = compact(low >> 1), c = compact(low);
+        if (rows_longer) r |= high;
+        else c |= high;
+        return {static_cast<std::size_t>(r), static_cast<std::size_t>(c)};
+    }
+
+    // Adds straight onto the interleaved coordinates, filling the other coordinate's bits
+    // with ones lets the carry ripple across them
+    constexpr std::size_t step(std::size_t idx, int dy, int dx) const {
+        std::uint64_t x = idx & col_mask;
+        std::uint64_t y = idx & row_mask;
+        if (dx > 0) x = ((x | row_mask) + index(0, static_cast<std::size_t>(dx))) & col_mask;
+        else if (dx < 0) x = (x - index(0, static_cast<std::size_t>(-dx))) & col_mask;
+        if (dy > 0) y = ((y | col_mask) + index(static_cast<std::size_t>(dy), 0)) & row_mask;
+        else if (dy < 0) y = (y - index(static_cast<std::size_t>(-dy), 0)) & row_mask;
+        return static_cast<std::size_t>(x | y);
+    }
+};
+
+// (dy, dx) of the neighbours, in the same order as offsets_8 / offsets_4
+inline constexpr std::array<std::pair<int, int>, 8> directions_8 = {{
+    {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1} }};
+inline constexpr std::array<std::pair<int, int>, 4> directions_4 = {{
+    {-1, 0}, {0, -1}, {0, 1}, {1, 0} }};
+
+template<typename T, typename Layout = RowMajor>
 struct Grid {
     std::size_t rows = 0;
     std::size_t cols = 0;
@@ -20,24 +169,31 @@ struct Grid {
     
     std::vector<T> data;
     
-    // Pre-calculated offsets for 1D navigation
+    // Pre-calculated offsets for 1D navigation, only filled for RowMajor
+    // Other layouts step with neighbour()
     std::vector<int> offsets_8; 
     std::vector<int> offsets_4; 
 
     T border_value;
 
+    Layout layout;
+
     Grid() = default;
 
     Grid(std::size_t r, std::size_t c, std::size_t pad = 1, T fill_val = T{}, T border_val = T{})
         : rows(r), cols(c), padding(pad), stride(c + 2 * pad), border_value(border_val) 
     {
-        data.assign((r + 2 * pad) * stride, border_val);
+        init_offsets();
+        data.assign(layout.size(), border_val);
         
         // Fill the inner area
         for(size_t i = 0; i < r; ++i) {
-            std::fill_n(row_begin(i), c, fill_val);
+            if constexpr (Layout::linear) {
+                std::fill_n(row_begin(i), c, fill_val);
+            } else {
+                for(size_t j = 0; j < c; ++j) operator()(i, j) = fill_val;
+            }
         }
-        init_offsets();
     }
 
     // From Vector of Strings
@@ -48,9 +204,10 @@ struct Grid {
         rows = lines.size();
         cols = lines[0].size();
         stride = cols + 2 * padding;
+        init_offsets();
         
         // Fill entire grid with border value first
-        data.assign((rows + 2 * padding) * stride, border_val);
+        data.assign(layout.size(), border_val);
 
         // Copy input data into the center
         for (size_t i = 0; i < rows; ++i) {
@@ -58,7 +215,6 @@ struct Grid {
                 operator()(i, j) = static_cast<T>(lines[i][j]);
             }
         }
-        init_offsets();
     }
 
     template <typename Func>
@@ -70,9 +226,10 @@ struct Grid {
         rows = lines.size();
         cols = lines[0].size();
         stride = cols + 2 * padding;
+        init_offsets();
         
         // Fill entire grid with border value first
-        data.assign((rows + 2 * padding) * stride, border_val);
+        data.assign(layout.size(), border_val);
 
         // Copy input data into the center using the transformer
         for (size_t i = 0; i < rows; ++i) {
@@ -81,13 +238,16 @@ struct Grid {
                 operator()(i, j) = static_cast<T>(transform(lines[i][j]));
             }
         }
-        init_offsets();
     }
 
+    // Sets up the layout and offsets from rows, cols, padding and stride
     void init_offsets() {
-        int s = static_cast<int>(stride);
-        offsets_8 = { -s-1, -s, -s+1, -1, 1, s-1, s, s+1 };
-        offsets_4 = { -s, -1, 1, s };
+        layout = Layout(rows + 2 * padding, stride);
+        if constexpr (Layout::linear) {
+            int s = static_cast<int>(stride);
+            offsets_8 = { -s-1, -s, -s+1, -1, 1, s-1, s, s+1 };
+            offsets_4 = { -s, -1, 1, s };
+        }
     }
 
     // Accessors
@@ -96,10 +256,10 @@ struct Grid {
     // (0, 0) is top of active content
     // Access (row, column)
     constexpr T& operator()(std::size_t r, std::size_t c) {
-        return data[(r + padding) * stride + (c + padding)];
+        return data[index_of(r, c)];
     }
     constexpr const T& operator()(std::size_t r, std::size_t c) const {
-        return data[(r + padding) * stride + (c + padding)];
+        return data[index_of(r, c)];
     }
 
     // 1D Raw Access
@@ -107,35 +267,45 @@ struct Grid {
     constexpr const T& operator[](std::size_t idx) const { return data[idx]; }
 
     // Iterator to start of row 'r' in the active area
-    auto row_begin(size_t r) { return data.begin() + (r + padding) * stride + padding; }
+    auto row_begin(size_t r) requires Layout::linear { return data.begin() + (r + padding) * stride + padding; }
 
     // Pointer to start of row 'r' in the active area
-    auto row_ptr(size_t r) const { return data.data() + (r + padding) * stride + padding; }
+    auto row_ptr(size_t r) const requires Layout::linear { return data.data() + (r + padding) * stride + padding; }
 
     // Coordinate conversions
     constexpr std::size_t index_of(std::size_t r, std::size_t c) const {
-        return (r + padding) * stride + (c + padding);
+        return layout.index(r + padding, c + padding);
     }
 
     // Should only use on valid active area indices
     constexpr std::pair<std::size_t, std::size_t> coord_of(std::size_t idx) const {
-        std::size_t r = (idx / stride) - padding;
-        std::size_t c = (idx % stride) - padding;
-        return {r, c};
+        auto [r, c] = layout.coord(idx);
+        return {r - padding, c - padding};
+    }
+
+    // Index of the cell dy rows down and dx columns right of idx
+    constexpr std::size_t neighbour(std::size_t idx, int dy, int dx) const {
+        return layout.step(idx, dy, dx);
     }
 
     // Count neighbors with specific value
     int count_neighbours(std::size_t idx, T val, bool diagonal = true) const {
         int cnt = 0;
-        const auto& offs = diagonal ? offsets_8 : offsets_4;
-        for (int off : offs) {
-            if (data[idx + off] == val) cnt++;
+        if constexpr (Layout::linear) {
+            const auto& offs = diagonal ? offsets_8 : offsets_4;
+            for (int off : offs) {
+                if (data[idx + off] == val) cnt++;
+            }
+        } else if (diagonal) {
+            for (auto [dy, dx] : directions_8) cnt += data[neighbour(idx, dy, dx)] == val;
+        } else {
+            for (auto [dy, dx] : directions_4) cnt += data[neighbour(idx, dy, dx)] == val;
         }
         return cnt;
     }
 
     T peek(std::size_t idx, int dy, int dx) const {
-        return data[idx + (dy * (int)stride) + dx];
+        return data[neighbour(idx, dy, dx)];
     }
 
     std::size_t find(T val) const {
@@ -157,6 +327,405 @@ struct Grid {
     }
 };
 
+// A cell and its neighbours as handed to stencil kernels
+template<typename T, int N>
+struct Neighbours;
+
+template<typename T>
+struct Neighbours<T, 4> {
+    T centre, n, w, e, s;
+};
+
+template<typename T>
+struct Neighbours<T, 8> {
+    T centre, nw, n, ne, w, e, sw, s, se;
+};
+
+// out(r, c) = kernel(neighbours of grid(r, c)) for every cell of the active area, N is 4 or 8
+// out must have the same rows, cols and padding, padding is read (so grid needs at least 1) but never written
+// out must not alias grid, rows are written while the row below is still to be read and the loop assumes
+// the pointers never overlap, run in place through a copy instead
+// Works a row at a time from three row pointers, nothing in the loop depends on the previous cell,
+// so simple kernels compile to vector loads of the three rows and a vector store
+template<int N = 8, typename T, typename U, typename Kernel>
+requires (N == 4 || N == 8) && std::invocable<Kernel&, const Neighbours<T, N>&>
+void stencil(const Grid<T>& grid, Grid<U>& out, Kernel&& kernel) {
+    assert(out.rows == grid.rows && out.cols == grid.cols && out.padding == grid.padding);
+    assert(grid.padding >= 1);
+    assert(static_cast<const void*>(&out) != static_cast<const void*>(&grid));
+    for (std::size_t r = 0; r < grid.rows; ++r) {
+        const T* __restrict mid = grid.row_ptr(r);
+        const T* __restrict up = mid - grid.stride;
+        const T* __restrict down = mid + grid.stride;
+        U* __restrict dst = out.data.data() + out.index_of(r, 0);
+
+        // Signed, c - 1 reaches into the left padding
+        for (std::ptrdiff_t c = 0; c < static_cast<std::ptrdiff_t>(grid.cols); ++c) {
+            if constexpr (N == 8) {
+                dst[c] = static_cast<U>(kernel(Neighbours<T, 8>{
+                    mid[c], up[c - 1], up[c], up[c + 1], mid[c - 1], mid[c + 1], down[c - 1], down[c], down[c + 1]}));
+            } else {
+                dst[c] = static_cast<U>(kernel(Neighbours<T, 4>{mid[c], up[c], mid[c - 1], mid[c + 1], down[c]}));
+            }
+        }
+    }
+}
+
+// Read only grid straight over text already in memory (an InputSource, embedded input), nothing is copied
+// Row r is line r, so the stride is the line length plus its line ending and
+// the '\n' after every row is a natural right border (and the left border of the next row)
+// There is no padding row above or below, count_neighbours and peek see border_value past either end
+// Every line must be as long as the first, the text has to outlive the view
+template<typename T = char>
+requires (sizeof(T) == 1)
+struct GridView {
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::size_t padding = 0;
+    std::size_t stride = 0;  // Line length + 1, or + 2 for "\r\n"
+
+    std::span<const T> data;
+
+    std::array<int, 8> offsets_8{};
+    std::array<int, 4> offsets_4{};
+
+    T border_value = static_cast<T>('\n');
+
+    GridView() = default;
+
+    explicit GridView(std::string_view text) {
+        // Trailing blank lines would otherwise count as short rows
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) text.remove_suffix(1);
+        if (text.empty()) return;
+
+        std::size_t nl = text.find('\n');
+        if (nl == std::string_view::npos) {
+            rows = 1;
+            cols = text.size();
+            stride = cols + 1;
+        } else {
+            cols = nl > 0 && text[nl - 1] == '\r' ? nl - 1 : nl;
+            stride = nl + 1;
+            // The last line has no line ending left
+            rows = (text.size() + stride - cols) / stride;
+        }
+        data = std::span<const T>(reinterpret_cast<const T*>(text.data()), text.size());
+
+        int s = static_cast<int>(stride);
+        offsets_8 = { -s-1, -s, -s+1, -1, 1, s-1, s, s+1 };
+        offsets_4 = { -s, -1, 1, s };
+    }
+
+    // Accessors
+
+    // (0, 0) is the first character of the text
+    constexpr const T& operator()(std::size_t r, std::size_t c) const { return data[r * stride + c]; }
+
+    constexpr const T& operator[](std::size_t idx) const { return data[idx]; }
+
+    // Pointer to start of row 'r'
+    const T* row_ptr(std::size_t r) const { return data.data() + r * stride; }
+
+    // Coordinate conversions
+    constexpr std::size_t index_of(std::size_t r, std::size_t c) const { return r * stride + c; }
+
+    constexpr std::pair<std::size_t, std::size_t> coord_of(std::size_t idx) const {
+        return {idx / stride, idx % stride};
+    }
+
+    // Count neighbors with specific value, cells outside the text are border_value
+    int count_neighbours(std::size_t idx, T val, bool diagonal = true) const {
+        int cnt = 0;
+        if (diagonal) {
+            for (int off : offsets_8) cnt += peek_at(idx, off) == val;
+        } else {
+            for (int off : offsets_4) cnt += peek_at(idx, off) == val;
+        }
+        return cnt;
+    }
+
+    T peek(std::size_t idx, int dy, int dx) const {
+        return peek_at(idx, dy * static_cast<int>(stride) + dx);
+    }
+
+    std::size_t find(T val) const {
+        auto it = std::ranges::find(data, val);
+        if (it == data.end()) return std::string::npos;
+        return std::distance(data.begin(), it);
+    }
+
+private:
+    T peek_at(std::size_t idx, int off) const {
+        std::size_t i = idx + off;
+        return i < data.size() ? data[i] : border_value;
+    }
+};
+
+// Rows and columns of text read as a grid, one row per line, columns from the first line
+// For the template arguments of StaticGrid, e.g. over embedded input:
+//   constexpr auto dims = Grid::text_dimensions(InputUtils::embedded_input);
+//   constexpr auto grid = Grid::StaticGrid<char, dims.first, dims.second>::from_text(InputUtils::embedded_input, '.');
+constexpr std::pair<std::size_t, std::size_t> text_dimensions(std::string_view text) {
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) text.remove_suffix(1);
+    if (text.empty()) return {0, 0};
+
+    std::size_t rows = 1;
+    for (char c : text) rows += c == '\n';
+    std::size_t cols = std::min(text.find('\n'), text.size());
+    if (cols > 0 && text[cols - 1] == '\r') cols--;
+    return {rows, cols};
+}
+
+// Grid with its size fixed at compile time
+// Same layout and API as Grid, but the storage is a std::array and stride, padding and the
+// neighbour offsets are constants, so index arithmetic folds and neighbour loops unroll
+// Everything is constexpr, small grids can be built from embedded input and solved in consteval code
+template<typename T, std::size_t Rows, std::size_t Cols, std::size_t Pad = 1>
+struct StaticGrid {
+    static constexpr std::size_t rows = Rows;
+    static constexpr std::size_t cols = Cols;
+    static constexpr std::size_t padding = Pad;
+    static constexpr std::size_t stride = Cols + 2 * Pad;  // Physical width
+
+    static constexpr int signed_stride = static_cast<int>(stride);
+    static constexpr std::array<int, 8> offsets_8 = {
+        -signed_stride - 1, -signed_stride, -signed_stride + 1, -1, 1, signed_stride - 1, signed_stride, signed_stride + 1 };
+    static constexpr std::array<int, 4> offsets_4 = { -signed_stride, -1, 1, signed_stride };
+
+    std::array<T, (Rows + 2 * Pad) * stride> data{};
+
+    constexpr StaticGrid() = default;
+
+    constexpr explicit StaticGrid(T fill_val, T border_val = T{}) {
+        data.fill(border_val);
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) operator()(i, j) = fill_val;
+        }
+    }
+
+    // One row per line of text, cells past the end of a short line are border_val
+    static constexpr StaticGrid from_text(std::string_view text, T border_val = T{}) {
+        return from_text(text, [](char c) { return static_cast<T>(c); }, border_val);
+    }
+
+    template <typename Func>
+    requires std::invocable<Func, char>
+    static constexpr StaticGrid from_text(std::string_view text, Func transform, T border_val = T{}) {
+        StaticGrid grid;
+        grid.data.fill(border_val);
+        std::size_t r = 0, c = 0;
+        for (std::size_t i = 0; i < text.size() && r < rows; ++i) {
+            char ch = text[i];
+            if (ch == '\n') {
+                r++;
+                c = 0;
+            } else if (ch != '\r' && c < cols) {
+                grid(r, c++) = static_cast<T>(transform(ch));
+            }
+        }
+        return grid;
+    }
+
+    // Accessors
+
+    // (0, 0) is top of active content
+    constexpr T& operator()(std::size_t r, std::size_t c) { return data[index_of(r, c)]; }
+    constexpr const T& operator()(std::size_t r, std::size_t c) const { return data[index_of(r, c)]; }
+
+    constexpr T& operator[](std::size_t idx) { return data[idx]; }
+    constexpr const T& operator[](std::size_t idx) const { return data[idx]; }
+
+    // Pointer to start of row 'r' in the active area
+    constexpr T* row_ptr(std::size_t r) { return data.data() + index_of(r, 0); }
+    constexpr const T* row_ptr(std::size_t r) const { return data.data() + index_of(r, 0); }
+
+    // Coordinate conversions
+    static constexpr std::size_t index_of(std::size_t r, std::size_t c) {
+        return (r + padding) * stride + (c + padding);
+    }
+
+    // Should only use on valid active area indices
+    static constexpr std::pair<std::size_t, std::size_t> coord_of(std::size_t idx) {
+        return {idx / stride - padding, idx % stride - padding};
+    }
+
+    // Count neighbors with specific value
+    constexpr int count_neighbours(std::size_t idx, T val, bool diagonal = true) const {
+        int cnt = 0;
+        if (diagonal) {
+            for (int off : offsets_8) cnt += data[idx + off] == val;
+        } else {
+            for (int off : offsets_4) cnt += data[idx + off] == val;
+        }
+        return cnt;
+    }
+
+    constexpr T peek(std::size_t idx, int dy, int dx) const {
+        return data[idx + dy * signed_stride + dx];
+    }
+
+    constexpr std::size_t find(T val) const {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            if (data[i] == val) return i;
+        }
+        return std::string::npos;
+    }
+};
+
+// One bit per cell, every row packed into 64 bit words, bit j of word w is column 64 * w + j
+// Rows carry an empty word on each side and there is an empty row above and below,
+// so the words around any cell can be read without bounds checks (the padding of Grid, a word wide)
+// Bits past cols in the last word of a row are always clear
+struct BitGrid {
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::size_t words = 0;   // Words of content per row
+    std::size_t stride = 0;  // Physical width in words = words + 2
+
+    std::vector<std::uint64_t> data;
+
+    BitGrid() = default;
+
+    BitGrid(std::size_t r, std::size_t c)
+        : rows(r), cols(c), words((c + 63) / 64), stride(words + 2)
+    {
+        data.assign((rows + 2) * stride, 0);
+    }
+
+    // Set where the cell of grid equals value
+    template<typename T>
+    BitGrid(const Grid<T>& grid, T value) : BitGrid(grid.rows, grid.cols) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            pack_row(grid.row_ptr(i), value, row_ptr(i));
+        }
+    }
+
+    // Set where the character of the line equals value
+    BitGrid(const std::vector<std::string>& lines, char value)
+        : BitGrid(lines.size(), lines.empty() ? 0 : lines[0].size())
+    {
+        for (std::size_t i = 0; i < rows; ++i) {
+            pack_row(lines[i].data(), value, row_ptr(i));
+        }
+    }
+
+    // Pack one row of cols cells, a word at a time
+    template<typename T>
+    void pack_row(const T* src, T value, std::uint64_t* dst) const {
+        for (std::size_t w = 0; w < words; ++w) {
+            std::size_t n = std::min<std::size_t>(64, cols - w * 64);
+            std::uint64_t word = 0;
+            for (std::size_t j = 0; j < n; ++j) {
+                word |= std::uint64_t{src[w * 64 + j] == value} << j;
+            }
+            dst[w] = word;
+        }
+    }
+
+    // First content word of row 'r'
+    std::uint64_t* row_ptr(std::size_t r) { return data.data() + (r + 1) * stride + 1; }
+    const std::uint64_t* row_ptr(std::size_t r) const { return data.data() + (r + 1) * stride + 1; }
+
+    bool get(std::size_t r, std::size_t c) const {
+        return (row_ptr(r)[c / 64] >> (c % 64)) & 1;
+    }
+
+    void set(std::size_t r, std::size_t c, bool value = true) {
+        std::uint64_t bit = std::uint64_t{1} << (c % 64);
+        if (value) row_ptr(r)[c / 64] |= bit;
+        else row_ptr(r)[c / 64] &= ~bit;
+    }
+
+    // Number of set cells
+    std::size_t count() const {
+        std::size_t n = 0;
+        for (std::uint64_t w : data) n += std::popcount(w);
+        return n;
+    }
+
+    BitGrid& operator&=(const BitGrid& other) {
+        for (std::size_t i = 0; i < data.size(); ++i) data[i] &= other.data[i];
+        return *this;
+    }
+
+    friend BitGrid operator&(BitGrid a, const BitGrid& b) { return a &= b; }
+
+    // Set neighbours of the 64 cells in word w of row r, as a 4 bit count per cell
+    // Bit j of slice k is bit k of the count for column 64 * w + j, counts run 0 to 8
+    // The eight shifted neighbour words are summed with carry-save adders, one full adder per bit position
+    std::array<std::uint64_t, 4> neighbour_counts(std::size_t r, std::size_t w, bool diagonal = true) const {
+        const std::uint64_t* up = row_ptr(r) - stride + w;
+        const std::uint64_t* mid = row_ptr(r) + w;
+        const std::uint64_t* down = row_ptr(r) + stride + w;
+
+        // Neighbour to the west / east of every cell lands on that cell's bit
+        auto west = [](const std::uint64_t* p) { return (p[0] << 1) | (p[-1] >> 63); };
+        auto east = [](const std::uint64_t* p) { return (p[0] >> 1) | (p[1] << 63); };
+
+        if (!diagonal) {
+            // Four inputs, pairs first then their carries
+            std::uint64_t a = up[0], b = down[0], c = west(mid), d = east(mid);
+            std::uint64_t s_ab = a ^ b, c_ab = a & b;
+            std::uint64_t s_cd = c ^ d, c_cd = c & d;
+            std::uint64_t s0 = s_ab ^ s_cd, c0 = s_ab & s_cd;
+            std::uint64_t s1 = c_ab ^ c_cd ^ c0;
+            std::uint64_t s2 = (c_ab & c_cd) | (c0 & (c_ab ^ c_cd));
+            return {s0, s1, s2, 0};
+        }
+
+        auto full_add = [](std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t& carry) {
+            std::uint64_t u = a ^ b;
+            carry = (a & b) | (u & c);
+            return u ^ c;
+        };
+
+        // Weight 1 inputs
+        std::uint64_t c_up, c_side, c_down, c_ones;
+        std::uint64_t s_up = full_add(west(up), up[0], east(up), c_up);
+        std::uint64_t s_side = full_add(west(mid), east(mid), west(down), c_side);
+        std::uint64_t s_down = down[0] ^ east(down);
+        c_down = down[0] & east(down);
+        std::uint64_t s0 = full_add(s_up, s_side, s_down, c_ones);
+
+        // Weight 2, four carries
+        std::uint64_t c_twos, c_last;
+        std::uint64_t t = full_add(c_up, c_side, c_down, c_twos);
+        std::uint64_t s1 = t ^ c_ones;
+        c_last = t & c_ones;
+
+        // Weight 4 and 8
+        return {s0, s1, c_twos ^ c_last, c_twos & c_last};
+    }
+
+    // Cells with fewer than threshold set neighbours, whether the cell itself is set or not
+    BitGrid neighbours_below(int threshold, bool diagonal = true) const {
+        BitGrid out(rows, cols);
+        std::uint64_t last_mask = cols % 64 ? (std::uint64_t{1} << (cols % 64)) - 1 : ~std::uint64_t{0};
+
+        for (std::size_t r = 0; r < rows; ++r) {
+            std::uint64_t* dst = out.row_ptr(r);
+            for (std::size_t w = 0; w < words; ++w) {
+                auto s = neighbour_counts(r, w, diagonal);
+
+                // count < threshold, compared bit slice by bit slice from the top bit down
+                std::uint64_t less = threshold > 8 ? ~std::uint64_t{0} : 0;
+                std::uint64_t equal = ~std::uint64_t{0};
+                for (int b = 3; b >= 0 && threshold > 0 && threshold <= 8; --b) {
+                    if (threshold >> b & 1) {
+                        less |= equal & ~s[b];
+                        equal &= s[b];
+                    } else {
+                        equal &= ~s[b];
+                    }
+                }
+
+                dst[w] = w + 1 == words ? less & last_mask : less;
+            }
+        }
+        return out;
+    }
+};
+
 } // namespace Grid
 
 #endif // GRID_H
\ No newline at end of file
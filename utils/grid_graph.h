@@ -9,9 +9,31 @@
 
 namespace Grid {
 
-template<typename T, typename Pred>
+// Call f(dy, dx) for the 4 or 8 neighbour directions
+template<typename F>
+void for_each_direction(bool diagonal, F&& f){
+    if(diagonal){
+        for(auto [dy, dx] : directions_8) f(dy, dx);
+    }else{
+        for(auto [dy, dx] : directions_4) f(dy, dx);
+    }
+}
+
+// Call f(neighbour index) for the 4 or 8 neighbours of idx
+// RowMajor adds the precomputed offsets, other layouts step through grid.neighbour
+template<typename T, typename Layout, typename F>
+void for_each_neighbour(const Grid<T, Layout>& grid, std::size_t idx, bool diagonal, F&& f){
+    if constexpr (Layout::linear){
+        for(int off : diagonal ? grid.offsets_8 : grid.offsets_4) f(idx + off);
+    }else{
+        for_each_direction(diagonal, [&](int dy, int dx){ f(grid.neighbour(idx, dy, dx)); });
+    }
+}
+
+// Both searches work with every storage layout
+template<typename T, typename Layout, typename Pred>
 std::optional<std::vector<std::size_t>> bfs_path(
-    const Grid<T>& grid,
+    const Grid<T, Layout>& grid,
     std::size_t start,
     std::size_t end,
     Pred can_step,
@@ -27,8 +49,6 @@ std::optional<std::vector<std::size_t>> bfs_path(
 
     parent[start] = start;
 
-    const auto& offsets = diagonal ? grid.offsets_8 : grid.offsets_4;
-
     // BFS Loop
     bool found = false;
     while(!q.empty()){
@@ -40,19 +60,18 @@ std::optional<std::vector<std::size_t>> bfs_path(
             break;
         }
 
-        for(int off : offsets){
-            std::size_t n_idx = curr + off;
+        for_each_neighbour(grid, curr, diagonal, [&](std::size_t n_idx){
 
             // Check if already visited
-            if(parent[n_idx] != NPOS) continue;
+            if(parent[n_idx] != NPOS) return;
 
             // Check if can step
-            if(!can_step(grid, curr, n_idx)) continue;
+            if(!can_step(grid, curr, n_idx)) return;
 
             // Mark parent and enqueue
             parent[n_idx] = curr;
             q.push_back(n_idx);
-        }
+        });
     }
     if(!found) return std::nullopt;
 
@@ -69,9 +88,9 @@ std::optional<std::vector<std::size_t>> bfs_path(
 }
 
 // Generic flood fill
-template<typename T, typename Pred>
+template<typename T, typename Layout, typename Pred>
 std::vector<int> bfs_map(
-    const Grid<T>& grid,
+    const Grid<T, Layout>& grid,
     std::size_t start,
     Pred can_step,
     bool diagonal = false
@@ -82,26 +101,23 @@ std::vector<int> bfs_map(
     std::vector<int> dist(grid.data.size(), -1);
     dist[start] = 0;
 
-    const auto& offsets = diagonal ? grid.offsets_8 : grid.offsets_4;
-
     // BFS Loop
     while(!q.empty()){
         std::size_t curr = q.front();
         q.pop_front();
 
-        for(int off : offsets){
-            std::size_t n_idx = curr + off;
+        for_each_neighbour(grid, curr, diagonal, [&](std::size_t n_idx){
 
             // Check if already visited
-            if(dist[n_idx] != -1) continue;
+            if(dist[n_idx] != -1) return;
 
             // Check if can step
-            if(!can_step(grid, curr, n_idx)) continue;
+            if(!can_step(grid, curr, n_idx)) return;
 
             // Mark seen and enqueue
             dist[n_idx] = dist[curr] + 1;
             q.push_back(n_idx);
-        }
+        });
     }
     return dist;
 }
@@ -9,10 +9,49 @@
 #include <string_view>
 #include <concepts>
 #include <cstdio>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <thread>
+#include <iterator>
+#include <algorithm>
+#include <ranges>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <array>
+#include <type_traits>
+#include <new>
+#include <numeric>
+#include <span>
+
+#include "string_utils.h"
+
+#if __has_include(<generator>)
+    #include <generator>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
+#endif
 
 
 namespace InputUtils {
 
+// Silences the "Using ..." source messages, errors are still printed
+// Set by the multi-day runner, whose days would otherwise interleave them
+inline std::atomic<bool> quiet{false};
+
 // Helper to read entire stream to string
 inline std::string read_stream(std::istream& in) {
     std::ostringstream sstr;
@@ -20,81 +59,642 @@ inline std::string read_stream(std::istream& in) {
     return sstr.str();
 }
 
+#if defined(__cpp_pp_embed) && defined(AOC_INPUT_FILE_PATH) && !defined(FORCE_FILE_IO)
+// Use embedded file
+// FORCE_FILE_IO can be used to override
+// static so every day gets its own copy, even when several days are linked together
+static constexpr char embedded_input_data[] = {
+    #embed AOC_INPUT_FILE_PATH
+    , '\0'
+};
+static constexpr std::string_view embedded_input{embedded_input_data, sizeof(embedded_input_data) - 1};
+static constexpr std::optional<std::string_view> embedded_source = embedded_input;
+#else
+static constexpr std::optional<std::string_view> embedded_source = std::nullopt;
+#endif
+
+// Read only memory mapping of a whole file
+// Only regular, non-empty files can be mapped, anything else (pipes, ttys) is left unopened
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        map(fd);
+        ::close(fd);
+#else
+        (void)path;
+#endif
+    }
+
+    // Map an already open descriptor, e.g. STDIN_FILENO when input is redirected from a file
+    explicit MappedFile(int fd) { map(fd); }
+
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+
+    bool is_open() const { return data != nullptr; }
+    std::string_view view() const { return {data, size}; }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+    void map([[maybe_unused]] int fd) {
+#if defined(__unix__) || defined(__APPLE__)
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) return;
+
+        void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) return;
+
+        // Lines are parsed front to back, let the kernel read ahead aggressively
+        ::madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        data = static_cast<const char*>(p);
+        size = static_cast<std::size_t>(st.st_size);
+#endif
+    }
+
+    void unmap() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (data) ::munmap(const_cast<char*>(data), size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+};
+
+// Owns the raw text of the puzzle input
+// Priority: command line file, embedded input, std::cin
+// Files (and stdin redirected from a file) are mapped so no copy is made,
+// pipes and unmappable files are read into a buffer instead
+class InputSource {
+public:
+    explicit InputSource(const std::string& input_file_path = "",
+                         std::optional<std::string_view> embedded = embedded_source) {
+        // Prioritise command line file if provided
+        if (!input_file_path.empty()) {
+            if (!quiet) std::println("Using file: {}", input_file_path);
+            mapping = MappedFile(input_file_path);
+            if (mapping.is_open()) return;
+
+            std::ifstream f(input_file_path);
+            if (!f.is_open()) {
+                std::println(stderr, "Error: Failed to open file '{}'.", input_file_path);
+                loaded = false;
+                return;
+            }
+            buffer = read_stream(f);
+            return;
+        }
+
+        if (embedded) {
+            if (!quiet) std::println("Using embedded input");
+            static_view = *embedded;
+            return;
+        }
+
+        if (!quiet) std::println("Reading from std::cin");
+#if defined(__unix__) || defined(__APPLE__)
+        mapping = MappedFile(STDIN_FILENO);
+        if (mapping.is_open()) return;
+#endif
+        buffer = read_stream(std::cin);
+    }
+
+    InputSource(const InputSource&) = delete;
+    InputSource& operator=(const InputSource&) = delete;
+
+    // False if the requested file could not be opened
+    bool ok() const { return loaded; }
+
+    // Views stay valid for the lifetime of the source
+    std::string_view view() const {
+        if (mapping.is_open()) return mapping.view();
+        if (static_view) return *static_view;
+        return buffer;
+    }
+
+private:
+    MappedFile mapping;
+    std::string buffer;
+    std::optional<std::string_view> static_view;
+    bool loaded = true;
+};
+
 // Require Func to be invocable with (std::string_view, Ret&)
 template<typename Func, typename Ret>
 concept LineParser = std::invocable<Func, std::string_view, Ret&>;
 
-// Generic input parser
-// PARSE_LINE_FUNCTION should match LineParser<RETURN_TYPE>
-template<typename RETURN_TYPE, LineParser <RETURN_TYPE> PARSE_LINE_FUNCTION>
-RETURN_TYPE parse_input(PARSE_LINE_FUNCTION& parse_line, std::string input_file_path = ""){
-    RETURN_TYPE ret;
-    std::string file_buffer;
-    std::string_view content_view;
-    bool loaded_source = false;
-
-    // Prioritise command line file if provided
-    if (!input_file_path.empty()) {
-        std::println("Using file: {}", input_file_path);
-        std::ifstream f(input_file_path);
-        if(f.is_open()) {
-            file_buffer = read_stream(f);
-            content_view = file_buffer;
-            loaded_source = true;
+// Finds newlines 64 bytes at a time
+// Each block is turned into a bitmask of '\n' positions which is reused until it runs out,
+// so the vector compare only happens once per block rather than once per line
+// Falls back to a plain search for the tail, at compile time and without SSE2
+class NewlineScanner {
+public:
+    static constexpr std::size_t block_size = 64;
+
+    constexpr NewlineScanner(const char* begin, const char* end)
+        : block(begin), block_end(begin), end(end) {}
+
+    // Position of the first '\n' at or after p, or end if there is none
+    constexpr const char* find(const char* p) {
+        if consteval {
+            return find_scalar(p);
         } else {
-            std::println(stderr, "Error: Failed to open file '{}'.", input_file_path);
-            return ret;
+#if defined(__AVX2__) || defined(__SSE2__)
+            while (p < end) {
+                // Reuse the mask of the current block while p is still inside it
+                if (p >= block && p < block_end) {
+                    std::uint64_t m = mask >> (p - block);
+                    if (m) return p + std::countr_zero(m);
+                    p = block_end;
+                    continue;
+                }
+                if (static_cast<std::size_t>(end - p) < block_size) return find_scalar(p);
+                block = p;
+                block_end = p + block_size;
+                mask = newline_mask(p);
+            }
+            return end;
+#else
+            const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+            return nl ? static_cast<const char*>(nl) : end;
+#endif
         }
     }
-    
-    if(!loaded_source){
-#if defined(__cpp_pp_embed) && defined(AOC_INPUT_FILE_PATH) && !defined(FORCE_FILE_IO)
-    // Use embedded file
-    // FORCE_FILE_IO can be used to override
-    static constexpr const char _input[] = {
-        #embed AOC_INPUT_FILE_PATH
-        , '\0'   
+
+private:
+    const char* block;
+    const char* block_end;
+    const char* end;
+    std::uint64_t mask = 0;
+
+    constexpr const char* find_scalar(const char* p) const {
+        while (p < end && *p != '\n') ++p;
+        return p;
+    }
+
+#if defined(__AVX2__)
+    static std::uint64_t newline_mask(const char* p) {
+        const __m256i nl = _mm256_set1_epi8('\n');
+        auto lo = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), nl)));
+        auto hi = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), nl)));
+        return (std::uint64_t{hi} << 32) | lo;
+    }
+#elif defined(__SSE2__)
+    static std::uint64_t newline_mask(const char* p) {
+        const __m128i nl = _mm_set1_epi8('\n');
+        std::uint64_t m = 0;
+        for (int i = 0; i < 4; ++i) {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+            m |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)))} << (16 * i);
+        }
+        return m;
+    }
+#endif
+};
+
+// Lazy range over the lines of some text
+// Yields views into the text with any trailing '\r' removed, nothing is allocated
+// A final newline does not produce an extra empty line
+class LineRange : public std::ranges::view_interface<LineRange> {
+public:
+    class iterator {
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        constexpr iterator() = default;
+        constexpr iterator(const char* begin, const char* end)
+            : scanner(begin, end), pos(begin), end(end) { advance(); }
+
+        constexpr std::string_view operator*() const { return line; }
+
+        constexpr iterator& operator++() { advance(); return *this; }
+        constexpr iterator operator++(int) { auto tmp = *this; advance(); return tmp; }
+
+        constexpr bool operator==(const iterator& other) const { return done == other.done && pos == other.pos; }
+        constexpr bool operator==(std::default_sentinel_t) const { return done; }
+
+    private:
+        NewlineScanner scanner{nullptr, nullptr};
+        const char* pos = nullptr;
+        const char* end = nullptr;
+        std::string_view line;
+        bool done = true;
+
+        constexpr void advance() {
+            if (pos == end) {
+                done = true;
+                return;
+            }
+            done = false;
+            const char* nl = scanner.find(pos);
+            line = std::string_view(pos, static_cast<std::size_t>(nl - pos));
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            pos = (nl == end) ? end : nl + 1;
+        }
     };
-    content_view = std::string_view(_input);
 
-    // Prevent unused variable warning
-    (void)input_file_path;
-    if (!content_view.empty() && content_view.back() == '\0') content_view.remove_suffix(1);
-    std::println("Using embedded input");
-#else
-    std::println("Reading from std::cin");
-    file_buffer = read_stream(std::cin);
-    content_view = file_buffer;
+    constexpr LineRange() = default;
+    constexpr explicit LineRange(std::string_view text) : text(text) {}
+
+    constexpr iterator begin() const { return iterator(text.data(), text.data() + text.size()); }
+    constexpr std::default_sentinel_t end() const { return {}; }
+
+private:
+    std::string_view text;
+};
+
+constexpr LineRange lines(std::string_view text) { return LineRange(text); }
+
+// Run parse_line over every line of content
+// Lines have any trailing '\r' removed
+template<typename RETURN_TYPE, LineParser <RETURN_TYPE> PARSE_LINE_FUNCTION>
+void parse_lines(std::string_view content_view, PARSE_LINE_FUNCTION& parse_line, RETURN_TYPE& ret){
+    for (auto line : lines(content_view)) {
+        parse_line(line, ret);
+    }
+}
+
+// Number of lines in text, counted the same way lines() splits them
+constexpr std::size_t count_lines(std::string_view text) {
+    std::size_t count = 0;
+    for (auto line : lines(text)) {
+        (void)line;
+        ++count;
+    }
+    return count;
+}
+
+// Compile time counterpart to parse_input
+// Each line is turned into one Record by parse_line(std::string_view) -> Record
+// N is usually count_lines(text), extra lines are ignored and missing ones left default constructed
+template<typename Record, std::size_t N, typename Func>
+requires std::is_invocable_r_v<Record, Func, std::string_view>
+consteval std::array<Record, N> parse_static(std::string_view text, Func parse_line) {
+    std::array<Record, N> result{};
+    std::size_t idx = 0;
+    for (auto line : lines(text)) {
+        if (idx == N) break;
+        result[idx++] = parse_line(line);
+    }
+    return result;
+}
 
+#if defined(__cpp_pp_embed) && defined(AOC_INPUT_FILE_PATH) && !defined(FORCE_FILE_IO)
+// Parse the embedded input at compile time into one Record per line
+// e.g. constexpr auto moves = InputUtils::parse_embedded<Move>(parse_line);
+template<typename Record, typename Func>
+requires std::is_invocable_r_v<Record, Func, std::string_view>
+consteval auto parse_embedded(Func parse_line) {
+    return parse_static<Record, count_lines(embedded_input)>(embedded_input, parse_line);
+}
+#endif
+
+// True if stdin is redirected from a regular file, which InputSource can map
+inline bool stdin_is_file() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct stat st;
+    return ::fstat(STDIN_FILENO, &st) == 0 && S_ISREG(st.st_mode);
+#else
+    return false;
 #endif
+}
+
+// Default block size for streaming input
+inline constexpr std::size_t stream_block_size = 1 << 20;
+
+// Reads in on one background thread into two buffers that the reader and the consumer take turns on,
+// so the next block is being read while the current one is used
+// One thread for the whole stream, blocks are handed over under a mutex
+class BlockReader {
+public:
+    BlockReader(std::istream& in, std::size_t block_size)
+        : in(in), buffers{std::vector<char>(block_size), std::vector<char>(block_size)},
+          worker([this] { run(); }) {}
+
+    BlockReader(const BlockReader&) = delete;
+    BlockReader& operator=(const BlockReader&) = delete;
+
+    // Waits for the worker, which may still be inside a blocking read
+    ~BlockReader() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        worker.join();
     }
 
-    std::size_t start = 0;
-    std::size_t end = 0;
-    
-    // Read line by line and parse
-    while ((end = content_view.find('\n', start)) != std::string_view::npos) {
-        auto line = content_view.substr(start, end - start);
-        
-        if (!line.empty() && line.back() == '\r') {
-            line.remove_suffix(1);
+    // Next block of the input, empty at the end
+    // Hands the previous block back to the reader, so it is only valid until the next call
+    std::span<const char> next() {
+        std::unique_lock lock(mutex);
+        if (taken) consumed = taken;
+        changed.notify_all();
+        changed.wait(lock, [&] { return filled > taken; });
+        const auto& buffer = buffers[taken % 2];
+        return {buffer.data(), sizes[taken++ % 2]};
+    }
+
+private:
+    std::istream& in;
+    std::array<std::vector<char>, 2> buffers;
+    std::array<std::size_t, 2> sizes{};
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::size_t filled = 0;    // Blocks read so far, block k lives in buffers[k % 2]
+    std::size_t taken = 0;     // Blocks handed to the consumer
+    std::size_t consumed = 0;  // Blocks the consumer is done with
+    bool stopping = false;
+    std::thread worker;
+
+    void run() {
+        for (std::size_t k = 0;; ++k) {
+            {
+                std::unique_lock lock(mutex);
+                // Block k reuses the buffer of block k - 2
+                changed.wait(lock, [&] { return stopping || k < consumed + 2; });
+                if (stopping) return;
+            }
+            auto& buffer = buffers[k % 2];
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            std::size_t n = static_cast<std::size_t>(in.gcount());
+            {
+                std::lock_guard lock(mutex);
+                sizes[k % 2] = n;
+                filled = k + 1;
+            }
+            changed.notify_all();
+            if (n == 0) return;
         }
+    }
+};
 
-        parse_line(line, ret);
-        start = end + 1;
+#if defined(__cpp_lib_generator)
+// Stream the lines of in without reading it all into memory
+// Input is read in blocks of block_size by a BlockReader, the next block is read on its thread
+// while the lines of the current one are being yielded
+// Only two blocks are held at once, plus the longest line that spans a block boundary
+// Yielded lines have any trailing '\r' removed and are only valid until the next line is requested
+inline std::generator<std::string_view> stream_lines(std::istream& in, std::size_t block_size = stream_block_size) {
+    auto strip = [](std::string_view line) {
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return line;
+    };
+
+    BlockReader reader(in, block_size);
+    std::string carry; // Start of a line that continues into the next block
+
+    for (auto block = reader.next(); !block.empty(); block = reader.next()) {
+        const char* pos = block.data();
+        const char* end = block.data() + block.size();
+        NewlineScanner scanner(pos, end);
+
+        for (const char* nl = scanner.find(pos); nl != end; nl = scanner.find(pos)) {
+            std::string_view line(pos, static_cast<std::size_t>(nl - pos));
+            if (carry.empty()) {
+                co_yield strip(line);
+            } else {
+                carry.append(line);
+                co_yield strip(carry);
+                carry.clear();
+            }
+            pos = nl + 1;
+        }
+        carry.append(pos, end);
     }
 
     // Handle potential last line with no newline at EOF
-    if (start < content_view.size()) {
-        auto line = content_view.substr(start);
-        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    if (!carry.empty()) co_yield strip(carry);
+}
+
+// Parse in line by line as it is read, see stream_lines
+template<typename RETURN_TYPE, LineParser <RETURN_TYPE> PARSE_LINE_FUNCTION>
+RETURN_TYPE parse_input_stream(PARSE_LINE_FUNCTION& parse_line, std::istream& in = std::cin,
+                               std::size_t block_size = stream_block_size){
+    RETURN_TYPE ret;
+    for (auto line : stream_lines(in, block_size)) {
         parse_line(line, ret);
     }
+    return ret;
+}
+#endif
+
+// Generic input parser
+// PARSE_LINE_FUNCTION should match LineParser<RETURN_TYPE>
+// Lines passed to parse_line point straight into the source and are only valid during the call
+// Piped stdin is streamed when std::generator is available, so memory stays bounded
+template<typename RETURN_TYPE, LineParser <RETURN_TYPE> PARSE_LINE_FUNCTION>
+RETURN_TYPE parse_input(PARSE_LINE_FUNCTION& parse_line, std::string input_file_path = ""){
+#if defined(__cpp_lib_generator)
+    if (input_file_path.empty() && !embedded_source && !stdin_is_file()) {
+        if (!quiet) std::println("Streaming from std::cin");
+        return parse_input_stream<RETURN_TYPE>(parse_line);
+    }
+#endif
+
+    RETURN_TYPE ret;
+
+    InputSource source(input_file_path);
+    if (!source.ok()) return ret;
+
+    parse_lines(source.view(), parse_line, ret);
 
     return ret;
 }
 
+// Containers whose parts can be joined by appending, e.g. std::vector
+template<typename T>
+concept Concatenable = requires(T& a, T& b) {
+    a.insert(a.end(), std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
+};
+
+// Default merge for parse_input_parallel, appends each chunk's results in order
+struct Concatenate {
+    template<Concatenable T>
+    void operator()(T& into, T&& from) const {
+        if (into.empty()) {
+            into = std::move(from);
+            return;
+        }
+        into.insert(into.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+    }
+};
+
+// Merge for map results, a key repeated in a later chunk replaces the earlier value as a serial parse would
+// std::map::merge would keep the earlier one instead
+struct OverwriteKeys {
+    template<typename Map>
+    void operator()(Map& into, Map&& from) const {
+        if (into.empty()) {
+            into = std::move(from);
+            return;
+        }
+        for (auto& [key, value] : from) {
+            into.insert_or_assign(key, std::move(value));
+        }
+    }
+};
+
+// Below this many bytes per thread it is cheaper to parse on one thread
+inline constexpr std::size_t parallel_min_chunk_size = 256 * 1024;
+
+// Split content into at most max_chunks pieces, every piece but the last ends just after a '\n'
+inline std::vector<std::string_view> split_chunks(std::string_view content, std::size_t max_chunks,
+                                                  std::size_t min_chunk_size = parallel_min_chunk_size) {
+    std::vector<std::string_view> chunks;
+    max_chunks = std::clamp<std::size_t>(content.size() / std::max<std::size_t>(min_chunk_size, 1), 1, std::max<std::size_t>(max_chunks, 1));
+
+    std::size_t start = 0;
+    for (std::size_t i = 1; i < max_chunks && start < content.size(); ++i) {
+        std::size_t target = std::max(start, content.size() * i / max_chunks);
+        std::size_t nl = content.find('\n', target);
+        if (nl == std::string_view::npos) break;
+        chunks.push_back(content.substr(start, nl + 1 - start));
+        start = nl + 1;
+    }
+    if (start < content.size() || chunks.empty()) chunks.push_back(content.substr(start));
+    return chunks;
+}
+
+// Parallel version of parse_input
+// The input is split at line boundaries, each chunk is parsed on its own thread into its own RETURN_TYPE
+// and the partial results are merged in input order with merge(into, std::move(from))
+// parse_line must not share mutable state between calls, e.g. a stateless (or static) lambda
+// Small inputs are parsed on the calling thread only
+template<typename RETURN_TYPE, LineParser <RETURN_TYPE> PARSE_LINE_FUNCTION, typename MERGE_FUNCTION = Concatenate>
+requires std::invocable<MERGE_FUNCTION&, RETURN_TYPE&, RETURN_TYPE&&>
+RETURN_TYPE parse_input_parallel(PARSE_LINE_FUNCTION& parse_line, std::string input_file_path = "",
+                                 MERGE_FUNCTION merge = {}, std::size_t threads = 0){
+    InputSource source(input_file_path);
+    if (!source.ok()) return RETURN_TYPE{};
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    auto chunks = split_chunks(source.view(), threads);
+
+    std::vector<RETURN_TYPE> parts(chunks.size());
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks.size() - 1);
+        for (std::size_t i = 1; i < chunks.size(); ++i) {
+            workers.emplace_back([&, i] { parse_lines(chunks[i], parse_line, parts[i]); });
+        }
+        parse_lines(chunks[0], parse_line, parts[0]);
+    } // Join workers
+
+    RETURN_TYPE ret = std::move(parts[0]);
+    for (std::size_t i = 1; i < parts.size(); ++i) {
+        merge(ret, std::move(parts[i]));
+    }
+    return ret;
+}
+
+// Allocator returning memory aligned to Alignment bytes
+// Used for columns that are read with aligned SIMD loads
+template<typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+    void deallocate(T* p, std::size_t n) noexcept {
+        ::operator delete(p, n * sizeof(T), std::align_val_t{Alignment});
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
+// Structure of arrays for inputs where every line is a fixed count of numbers
+// Each column is contiguous and 64 byte aligned, so loops over one coordinate vectorise
+template<typename T, std::size_t Columns>
+struct NumericTable {
+    using Column = std::vector<T, AlignedAllocator<T>>;
+
+    std::array<Column, Columns> columns;
+
+    std::size_t size() const { return columns[0].size(); }
+
+    Column& operator[](std::size_t c) { return columns[c]; }
+    const Column& operator[](std::size_t c) const { return columns[c]; }
+
+    // Append the rows of other after this table's rows
+    void append(NumericTable&& other) {
+        for (std::size_t c = 0; c < Columns; ++c) {
+            if (columns[c].empty()) columns[c] = std::move(other.columns[c]);
+            else columns[c].insert(columns[c].end(), other.columns[c].begin(), other.columns[c].end());
+        }
+    }
+
+    // Reorder rows so that new row i is old row order[i]
+    void permute(std::span<const std::size_t> order) {
+        for (auto& column : columns) {
+            Column sorted(order.size());
+            for (std::size_t i = 0; i < order.size(); ++i) sorted[i] = column[order[i]];
+            column = std::move(sorted);
+        }
+    }
+
+    // Row permutation that sorts the table by column c
+    std::vector<std::size_t> order_by(std::size_t c) const {
+        std::vector<std::size_t> order(size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::ranges::sort(order, [&](std::size_t a, std::size_t b) { return columns[c][a] < columns[c][b]; });
+        return order;
+    }
+};
+
+// Parse lines of exactly Columns numbers into a NumericTable in a single pass
+// Lines with any other count of numbers (e.g. blank lines) are skipped
+// T sets the element width, large inputs are parsed in parallel
+template<typename T, std::size_t Columns>
+NumericTable<T, Columns> parse_numeric_table(std::string input_file_path = ""){
+    static auto parse_line = [](std::string_view line, NumericTable<T, Columns>& table) {
+        // One spare slot so lines with too many numbers are rejected
+        std::array<T, Columns + 1> values{};
+        if (StringUtils::extract_numbers(line, std::span(values)) != Columns) return;
+        for (std::size_t c = 0; c < Columns; ++c) {
+            table.columns[c].push_back(values[c]);
+        }
+    };
+    static auto merge = [](auto& into, auto&& from) {
+        into.append(std::move(from));
+    };
+
+    return parse_input_parallel<NumericTable<T, Columns>>(parse_line, input_file_path, merge);
+}
+
 } // namespace InputUtils
 
 
-#endif // INPUT_H
\ No newline at end of file
+#endif // INPUT_H
@@ -0,0 +1,235 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
+
+#include "input.h"
+#include "grid.h"
+
+// Binary cache of parsed input
+// A snapshot is a list of sections, each a flat array of trivially copyable elements,
+// keyed by a hash of the input text, the layout tag and the writing source, so it is ignored as soon as any of them changes
+// Sections are 64 byte aligned, readers map the file and use the arrays in place
+//
+// Layout:
+//   Header
+//   SectionEntry[sections]
+//   section payloads, each starting on a 64 byte boundary
+namespace Snapshot {
+
+// Bump whenever the file layout changes
+inline constexpr std::uint32_t VERSION = 1;
+inline constexpr std::array<char, 8> MAGIC = {'A', 'O', 'C', 'S', 'N', 'A', 'P', '\0'};
+inline constexpr std::size_t ALIGNMENT = 64;
+
+struct Header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t sections;
+    std::uint64_t key;
+};
+
+struct SectionEntry {
+    std::uint64_t offset;
+    std::uint64_t bytes;
+    std::uint64_t element_size;
+};
+
+// Fast non-cryptographic hash, 8 bytes per step
+inline std::uint64_t hash_bytes(std::string_view data, std::uint64_t seed = 0) {
+    auto mix = [](std::uint64_t x) {
+        x ^= x >> 31;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        return x;
+    };
+
+    std::uint64_t h = seed ^ (data.size() * 0x9e3779b97f4a7c15ULL);
+    std::size_t i = 0;
+    for (; i + 8 <= data.size(); i += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, data.data() + i, 8);
+        h = (h ^ mix(w)) * 0x94d049bb133111ebULL;
+    }
+    std::uint64_t tail = 0;
+    // data() may be null for empty input, memcpy from null is undefined even for 0 bytes
+    if (i < data.size()) std::memcpy(&tail, data.data() + i, data.size() - i);
+    h = (h ^ mix(tail)) * 0x94d049bb133111ebULL;
+    return mix(h);
+}
+
+// Identity of the code that wrote a snapshot, so editing a day's parser invalidates its snapshots
+// even when the tag was not bumped
+// CMake defines it per source file from a hash of that file (aoc_snapshot_source), empty otherwise
+#ifndef SNAPSHOT_BUILD_ID
+    #define SNAPSHOT_BUILD_ID ""
+#endif
+
+// Key for a snapshot of input, layout_tag names the parsed structure
+// Bump the tag on ANY change to what the parser produces, not only to the types or section order,
+// build_id is only a safety net, it misses changes to headers the parser uses
+inline std::uint64_t input_key(std::string_view input, std::string_view layout_tag, std::string_view build_id) {
+    return hash_bytes(input, hash_bytes(build_id, hash_bytes(layout_tag)));
+}
+
+// Cleared to always parse, e.g. by benchmarks that must time the parse rather than a cache hit
+inline bool enabled = true;
+
+// Where to keep the snapshot for an input file, next to the file or in the working directory for embedded input
+inline std::string path_for(const std::string& input_file, std::string_view name) {
+    if (input_file.empty()) return std::string(name) + ".snap";
+    return input_file + "." + std::string(name) + ".snap";
+}
+
+// Dimensions of a serialised grid, stored as its own section before the data
+struct GridInfo {
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint64_t padding;
+};
+
+class Writer {
+public:
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    void add(std::span<const T> data) {
+        sections.push_back(Pending{
+            std::string(reinterpret_cast<const char*>(data.data()), data.size_bytes()),
+            sizeof(T)
+        });
+    }
+
+    template<typename T>
+    void add(const std::vector<T>& data) { add(std::span<const T>(data)); }
+
+    // Adds three sections, GridInfo, the border value and the raw data including padding
+    template<typename T>
+    void add(const Grid::Grid<T>& grid) {
+        GridInfo info{grid.rows, grid.cols, grid.padding};
+        add(std::span<const GridInfo>(&info, 1));
+        add(std::span<const T>(&grid.border_value, 1));
+        add(grid.data);
+    }
+
+    // Write to a temporary file then rename, so a reader never sees a partial snapshot
+    bool save(const std::string& path, std::uint64_t key) const {
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+
+            Header header{MAGIC, VERSION, static_cast<std::uint32_t>(sections.size()), key};
+            std::vector<SectionEntry> entries;
+            std::uint64_t offset = align(sizeof(Header) + sections.size() * sizeof(SectionEntry));
+            for (const auto& s : sections) {
+                entries.push_back(SectionEntry{offset, s.bytes.size(), s.element_size});
+                offset = align(offset + s.bytes.size());
+            }
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(SectionEntry));
+            for (std::size_t i = 0; i < sections.size(); ++i) {
+                pad_to(out, entries[i].offset);
+                out.write(sections[i].bytes.data(), sections[i].bytes.size());
+            }
+            if (!out) return false;
+        }
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+private:
+    struct Pending {
+        std::string bytes;
+        std::size_t element_size;
+    };
+    std::vector<Pending> sections;
+
+    static std::uint64_t align(std::uint64_t x) { return (x + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+    static void pad_to(std::ofstream& out, std::uint64_t offset) {
+        static constexpr char zeros[ALIGNMENT] = {};
+        auto pos = static_cast<std::uint64_t>(out.tellp());
+        if (pos < offset) out.write(zeros, static_cast<std::streamsize>(offset - pos));
+    }
+};
+
+class Reader {
+public:
+    // Map the snapshot at path
+    // False if it is missing, from another format version, for a different input or malformed
+    bool open(const std::string& path, std::uint64_t key) {
+        mapping = InputUtils::MappedFile(path);
+        entries = {};
+        if (!mapping.is_open()) return false;
+
+        auto bytes = mapping.view();
+        if (bytes.size() < sizeof(Header)) return close();
+
+        Header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION || header.key != key) return close();
+
+        std::size_t table_end = sizeof(Header) + std::size_t{header.sections} * sizeof(SectionEntry);
+        if (bytes.size() < table_end) return close();
+        entries = std::span(reinterpret_cast<const SectionEntry*>(bytes.data() + sizeof(Header)), header.sections);
+
+        for (const auto& e : entries) {
+            if (e.offset % ALIGNMENT != 0 || e.offset + e.bytes > bytes.size()) return close();
+        }
+        return true;
+    }
+
+    bool is_open() const { return mapping.is_open(); }
+    std::size_t sections() const { return entries.size(); }
+
+    // Section i viewed in place, empty if it does not hold T
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    std::span<const T> span(std::size_t i) const {
+        if (i >= entries.size() || entries[i].element_size != sizeof(T)) return {};
+        const auto& e = entries[i];
+        return {reinterpret_cast<const T*>(mapping.view().data() + e.offset), e.bytes / sizeof(T)};
+    }
+
+    // Rebuild a grid written with Writer::add(grid), starting at section i
+    template<typename T>
+    Grid::Grid<T> grid(std::size_t i) const {
+        auto info = span<GridInfo>(i);
+        auto border = span<T>(i + 1);
+        auto data = span<T>(i + 2);
+        if (info.size() != 1 || border.size() != 1) return {};
+
+        Grid::Grid<T> g;
+        g.rows = info[0].rows;
+        g.cols = info[0].cols;
+        g.padding = info[0].padding;
+        g.stride = g.cols + 2 * g.padding;
+        g.border_value = border[0];
+        g.data.assign(data.begin(), data.end());
+        g.init_offsets();
+        return g;
+    }
+
+private:
+    InputUtils::MappedFile mapping;
+    std::span<const SectionEntry> entries;
+
+    bool close() {
+        mapping = InputUtils::MappedFile();
+        entries = {};
+        return false;
+    }
+};
+
+} // namespace Snapshot
+
+#endif // SNAPSHOT_H
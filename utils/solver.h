@@ -0,0 +1,107 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <any>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include "input.h"
+#include "timer.h"
+
+// Registry of every day's solution, so one executable can run any subset of days in process
+// Each day registers its parse, part 1 and part 2 functions with AOC_REGISTER_DAY
+// Parsed input is type erased in a Solver::Input, answers are formatted to strings
+namespace Solver {
+
+// Parsed input of any day, shared so parts can take it by reference without copying
+using Input = std::any;
+
+struct Day {
+    int number = 0;
+    bool embedded = false; // Built with the day's input embedded, an empty path uses it
+    std::function<Input(const std::string&)> parse;
+    std::function<std::string(Input&)> p1;
+    std::function<std::string(Input&)> p2; // Empty for days with a single part
+};
+
+// Stand in for a missing part
+struct NoPart {
+    template <typename I>
+    std::nullopt_t operator()(I&) const { return std::nullopt; }
+};
+inline constexpr NoPart no_part{};
+
+inline std::vector<Day>& registry() {
+    static std::vector<Day> days;
+    return days;
+}
+
+// Registered days ordered by number
+inline std::vector<Day> days() {
+    auto d = registry();
+    std::ranges::sort(d, {}, &Day::number);
+    return d;
+}
+
+// Input file for a day, empty to use its embedded input
+// Days without embedded input, or every day when dir is given, read dir/dayN/input.txt
+inline std::string input_path(const Day& day, const std::optional<std::string>& dir = std::nullopt) {
+    if (!dir && day.embedded) return "";
+    return std::format("{}/day{}/input.txt", dir.value_or("inputs"), day.number);
+}
+
+// Silence the per day "[Timer]" and "Using ..." lines
+inline void set_quiet(bool q) {
+    Timer::quiet = q;
+    InputUtils::quiet = q;
+}
+
+// Wrap typed functions into a Day
+// The parsed value is held by shared_ptr so std::any never copies it, move only inputs are fine
+template <typename Parse, typename Part1, typename Part2>
+Day make_day(int number, bool embedded, Parse parse, Part1 part1, Part2 part2) {
+    using Parsed = std::decay_t<std::invoke_result_t<Parse, const std::string&>>;
+
+    auto get = [](Input& input) -> Parsed& { return *std::any_cast<std::shared_ptr<Parsed>&>(input); };
+
+    Day day;
+    day.number = number;
+    day.embedded = embedded;
+    day.parse = [parse](const std::string& path) -> Input {
+        return std::make_shared<Parsed>(parse(path));
+    };
+    day.p1 = [part1, get](Input& input) { return std::format("{}", part1(get(input))); };
+    if constexpr (!std::is_same_v<std::invoke_result_t<Part2, Parsed&>, std::nullopt_t>) {
+        day.p2 = [part2, get](Input& input) { return std::format("{}", part2(get(input))); };
+    }
+    return day;
+}
+
+struct Registrar {
+    explicit Registrar(Day day) { registry().push_back(std::move(day)); }
+};
+
+} // namespace Solver
+
+// Register a day with the runner, only compiled into the AOC2025 executable
+// parse takes the input path, part1 and part2 take the parsed input by reference
+// Any of them can be a lambda, use Solver::no_part for a day without a second part
+#ifdef AOC_RUNNER
+    #define AOC_REGISTER_DAY(number, parse, part1, part2)                                   \
+        static const ::Solver::Registrar TIMER_CONCAT(aoc_registrar_day_, number){          \
+            ::Solver::make_day(number, ::InputUtils::embedded_source.has_value(),           \
+                [](const std::string& path) { return parse(path); },                        \
+                [](auto& input) { return part1(input); },                                   \
+                [](auto& input) { return part2(input); })}
+#else
+    #define AOC_REGISTER_DAY(number, parse, part1, part2) static_assert(true)
+#endif
+
+#endif // SOLVER_H
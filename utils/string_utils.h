@@ -7,6 +7,13 @@
 #include <algorithm>
 #include <numeric>
 #include <ranges>
+#include <optional>
+#include <charconv>
+#include <cstdint>
+#include <span>
+#include <bit>
+
+#include "cpu_dispatch.h"
 
 
 namespace StringUtils {
@@ -19,6 +26,15 @@ T to_num(std::string_view sv) {
     return val;
 }
 
+// Checked single number parser, nullopt unless all of sv is a number that fits in T
+template<typename T = int64_t>
+std::optional<T> try_to_num(std::string_view sv) {
+    T val = 0;
+    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), val);
+    if (ec != std::errc() || ptr != sv.data() + sv.size()) return std::nullopt;
+    return val;
+}
+
 // Trim spaces from start (in place)
 inline void ltrim(std::string &s) {
     s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) {
@@ -102,42 +118,239 @@ inline std::vector<std::string_view> split(std::string_view s, std::string_view
     return parts;
 }
 
-template <typename T = int64_t>
-std::vector<T> extract_numbers(std::string_view sv) {
-    std::vector<T> numbers;
-    const char* ptr = sv.data();
-    const char* end = sv.data() + sv.size();
+// Lazy split of a string_view, tokens are views into s and nothing is allocated
+// Yields the same tokens as split(): empty tokens are kept and there is always at least one
+// Delimiter is either a char or a std::string_view
+template <typename Delimiter>
+class SplitView : public std::ranges::view_interface<SplitView<Delimiter>> {
+public:
+    class iterator {
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
 
-    while (ptr < end) {
-        // Skip non-digit characters
-        // If T is signed,  allow '-' as a start char if followed by a digit
-        bool is_sign = false;
-        if constexpr (std::is_signed_v<T>) {
-            if (*ptr == '-') {
-                if (ptr + 1 < end && std::isdigit(*(ptr + 1))) {
-                    is_sign = true;
-                }
+        constexpr iterator() = default;
+        constexpr iterator(std::string_view s, Delimiter delimiter) : rest(s), delimiter(delimiter), last(false) { advance(); }
+
+        constexpr std::string_view operator*() const { return token; }
+
+        constexpr iterator& operator++() { advance(); return *this; }
+        constexpr iterator operator++(int) { auto tmp = *this; advance(); return tmp; }
+
+        constexpr bool operator==(const iterator& other) const {
+            return done == other.done && (done || token.data() == other.token.data());
+        }
+        constexpr bool operator==(std::default_sentinel_t) const { return done; }
+
+    private:
+        std::string_view rest;
+        std::string_view token;
+        Delimiter delimiter{};
+        bool last = true;
+        bool done = true;
+
+        constexpr std::size_t delimiter_size() const {
+            if constexpr (std::is_same_v<Delimiter, char>) return 1;
+            else return delimiter.size();
+        }
+
+        constexpr void advance() {
+            if (last) {
+                done = true;
+                return;
+            }
+            done = false;
+            std::size_t end = delimiter_size() == 0 ? std::string_view::npos : rest.find(delimiter);
+            if (end == std::string_view::npos) {
+                token = rest;
+                last = true;
+                return;
             }
+            token = rest.substr(0, end);
+            rest.remove_prefix(end + delimiter_size());
         }
+    };
+
+    constexpr SplitView() = default;
+    constexpr SplitView(std::string_view s, Delimiter delimiter) : s(s), delimiter(delimiter) {}
+
+    constexpr iterator begin() const { return iterator(s, delimiter); }
+    constexpr std::default_sentinel_t end() const { return {}; }
+
+private:
+    std::string_view s;
+    Delimiter delimiter{};
+};
+
+// Lazily split string_view by delimiter
+constexpr SplitView<char> split_view(std::string_view s, char delimiter) {
+    return SplitView<char>(s, delimiter);
+}
+
+// Lazily split string_view by a string delimiter (e.g. ", ")
+constexpr SplitView<std::string_view> split_view(std::string_view s, std::string_view delimiter) {
+    return SplitView<std::string_view>(s, delimiter);
+}
+
+namespace detail {
+
+constexpr bool is_digit(char c) { return static_cast<unsigned char>(c - '0') <= 9; }
 
-        if (!std::isdigit(*ptr) && !is_sign) {
-            ++ptr;
-            continue;
+// Bitmask of the digits among the n <= 64 bytes at p, bit i set for p[i]
+// Digits are the bytes where (c - '0') as unsigned is at most 9
+// No variant reads past p + n
+inline std::uint64_t digit_mask_scalar(const char* p, std::size_t n) {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        mask |= std::uint64_t{is_digit(p[i])} << i;
+    }
+    return mask;
+}
+
+#if CPU_DISPATCH_X86
+AOC_TARGET_SSE42 inline std::uint64_t digit_mask16(const char* p) {
+    __m128i d = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+    return static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d)));
+}
+
+AOC_TARGET_SSE42 inline std::uint64_t digit_mask_sse42(const char* p, std::size_t n) {
+    std::uint64_t mask = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) mask |= digit_mask16(p + i) << i;
+    for (; i < n; ++i) mask |= std::uint64_t{is_digit(p[i])} << i;
+    return mask;
+}
+
+AOC_TARGET_AVX2 inline std::uint64_t digit_mask_avx2(const char* p, std::size_t n) {
+    std::uint64_t mask = 0;
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i d = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), _mm256_set1_epi8('0'));
+        mask |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d)))} << i;
+    }
+    if (i + 16 <= n) {
+        mask |= digit_mask16(p + i) << i;
+        i += 16;
+    }
+    for (; i < n; ++i) mask |= std::uint64_t{is_digit(p[i])} << i;
+    return mask;
+}
+
+// Masked load and compare, the bytes past n are never touched so any length is one pass
+AOC_TARGET_AVX512 inline std::uint64_t digit_mask_avx512(const char* p, std::size_t n) {
+    __mmask64 valid = _bzhi_u64(~std::uint64_t{0}, static_cast<unsigned>(n));
+    __m512i d = _mm512_sub_epi8(_mm512_maskz_loadu_epi8(valid, p), _mm512_set1_epi8('0'));
+    return _mm512_mask_cmple_epu8_mask(valid, d, _mm512_set1_epi8(9));
+}
+
+inline constexpr CpuDispatch::Kernel<std::uint64_t(const char*, std::size_t)> digit_mask{
+    digit_mask_scalar, digit_mask_sse42, digit_mask_avx2, digit_mask_avx512};
+#else
+inline constexpr CpuDispatch::Kernel<std::uint64_t(const char*, std::size_t)> digit_mask{digit_mask_scalar};
+#endif
+
+// Finds digit / non-digit boundaries a block at a time
+// Each block is classified once into a bitmask of digit positions, which is then reused
+// to find both the start and the end of every number inside it
+// Blocks are 64 bytes, or whatever is left at the end, classified by the best digit_mask the CPU supports
+class DigitScanner {
+public:
+    static constexpr std::size_t block_size = 64;
+
+    DigitScanner(const char* begin, const char* end) : block(begin), block_end(begin), end(end) {}
+
+    // First position at or after p that is (or is not) a digit, or end
+    const char* find(const char* p, bool digit) {
+        while (p < end) {
+            if (p >= block && p < block_end) {
+                std::uint64_t m = ((digit ? mask : ~mask) & valid) >> (p - block);
+                if (m) return p + std::countr_zero(m);
+                p = block_end;
+                continue;
+            }
+            load_block(p);
         }
+        return end;
+    }
 
-        // Parse the number
-        T value;
-        auto result = std::from_chars(ptr, end, value);
+private:
+    const char* block;
+    const char* block_end;
+    const char* end;
+    std::uint64_t mask = 0;
+    std::uint64_t valid = 0; // Bits of mask that lie inside the block
+
+    // Only called with p < end, so a block is never empty
+    void load_block(const char* p) {
+        std::size_t n = std::min(static_cast<std::size_t>(end - p), block_size);
+        block = p;
+        block_end = p + n;
+        mask = digit_mask(p, n);
+        valid = ~std::uint64_t{0} >> (64 - n);
+    }
+};
+
+} // namespace detail
+
+// Call emit(value) for every number in sv, stops early if emit returns false
+// If T is signed, a '-' directly before a number is taken as its sign
+// Numbers that overflow T are skipped
+template <typename T, typename Emit>
+void for_each_number(std::string_view sv, Emit&& emit) {
+    const char* begin = sv.data();
+    const char* end = sv.data() + sv.size();
+    detail::DigitScanner scanner(begin, end);
 
+    const char* ptr = begin;
+    while (ptr < end) {
+        const char* first = scanner.find(ptr, true);
+        if (first == end) break;
+        const char* last = scanner.find(first, false);
+
+        const char* start = first;
+        if constexpr (std::is_signed_v<T>) {
+            if (first > begin && first[-1] == '-') --start;
+        }
+
+        T value;
+        auto result = std::from_chars(start, last, value);
         if (result.ec == std::errc()) {
-            numbers.push_back(value);
-            ptr = result.ptr; // Move pointer to end of parsed number
-        } else {
-            ++ptr; 
+            if (!emit(value)) return;
         }
+        ptr = last;
     }
+}
+
+// Append every number in sv to out, reusing its capacity
+template <typename T>
+void extract_numbers(std::string_view sv, std::vector<T>& out) {
+    for_each_number<T>(sv, [&](T v) { out.push_back(v); return true; });
+}
+
+// Write numbers from sv into out until it is full
+// Returns how many were written
+template <typename T, std::size_t Extent>
+std::size_t extract_numbers(std::string_view sv, std::span<T, Extent> out) {
+    std::size_t n = 0;
+    for_each_number<T>(sv, [&](T v) {
+        if (n == out.size()) return false;
+        out[n++] = v;
+        return true;
+    });
+    return n;
+}
+
+template <typename T = int64_t>
+std::vector<T> extract_numbers(std::string_view sv) {
+    std::vector<T> numbers;
+    extract_numbers(sv, numbers);
     return numbers;
 }
 
 } // namespace StringUtils
+
+// Split iterators only point into the original string, so they may outlive the view
+template <typename Delimiter>
+inline constexpr bool std::ranges::enable_borrowed_range<StringUtils::SplitView<Delimiter>> = true;
 #endif // STRING_UTILS_H
\ No newline at end of file
@@ -5,6 +5,19 @@
 #include <string>
 #include <iomanip>
 #include <sstream>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <optional>
+#include <atomic>
+#include <fstream>
+#include <cstdlib>
 
 #if defined(_WIN32)
     #include <windows.h>
@@ -14,6 +27,31 @@
     #include <sys/resource.h>
 #endif
 
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define TIMER_HAS_TSC 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+        #include <cpuid.h>
+    #endif
+#else
+    #define TIMER_HAS_TSC 0
+#endif
+
+#ifdef AOC_TRACK_ALLOCATIONS
+    #include "alloc_tracker.h"
+#endif
+
 namespace Timer{
     class HighResTimer {
     public:
@@ -74,14 +112,101 @@ namespace Timer{
                 return double(std::clock()) / CLOCKS_PER_SEC; // fallback
             #endif
         }
+
+        // Time stamp counter, fenced on both sides so the code being timed can not move across it
+        static std::uint64_t tsc_begin() {
+            #if TIMER_HAS_TSC
+                _mm_lfence();
+                std::uint64_t t = __rdtsc();
+                _mm_lfence();
+                return t;
+            #else
+                return 0;
+            #endif
+        }
+
+        // rdtscp waits for everything before it to finish, the fence keeps later code from starting early
+        static std::uint64_t tsc_end() {
+            #if TIMER_HAS_TSC
+                unsigned int aux;
+                std::uint64_t t = __rdtscp(&aux);
+                _mm_lfence();
+                return t;
+            #else
+                return 0;
+            #endif
+        }
+
+        // Invariant TSC ticks at a constant rate through frequency changes and sleep states,
+        // CPUID leaf 0x80000007, EDX bit 8
+        static bool tsc_invariant() {
+            #if TIMER_HAS_TSC
+                #if defined(_MSC_VER)
+                    int regs[4];
+                    __cpuid(regs, 0x80000000);
+                    if (static_cast<unsigned>(regs[0]) < 0x80000007u) return false;
+                    __cpuid(regs, 0x80000007);
+                    return regs[3] & (1 << 8);
+                #else
+                    unsigned int eax, ebx, ecx, edx;
+                    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007u) return false;
+                    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+                    return edx & (1u << 8);
+                #endif
+            #else
+                return false;
+            #endif
+        }
+
+        struct TscCalibration {
+            bool usable = false;       // Invariant TSC on x86, otherwise Cycles mode uses global_now
+            double ticks_per_ns = 0.0;
+            std::uint64_t base = 0;    // Readings are taken relative to this to keep double precision
+        };
+
+        // Measured once, on first Cycles use, by counting ticks over 20 ms of the monotonic clock
+        static const TscCalibration& tsc_calibration() {
+            static const TscCalibration calibration = [] {
+                TscCalibration c;
+                if (!tsc_invariant()) {
+                    std::cerr << "[Timer] TSC is not invariant, Cycles mode falls back to the monotonic clock\n";
+                    return c;
+                }
+                double t0 = global_now();
+                std::uint64_t c0 = tsc_begin();
+                double t1 = t0;
+                while (t1 - t0 < 0.02) t1 = global_now();
+                std::uint64_t c1 = tsc_end();
+
+                c.usable = c1 > c0;
+                c.ticks_per_ns = double(c1 - c0) / ((t1 - t0) * 1e9);
+                c.base = c0;
+                return c;
+            }();
+            return calibration;
+        }
+
+        // Seconds from the TSC, begin and end readings fence differently
+        static double cycles_now(bool end = false) {
+            const auto& c = tsc_calibration();
+            if (!c.usable) return global_now();
+            std::uint64_t t = end ? tsc_end() : tsc_begin();
+            return double(static_cast<std::int64_t>(t - c.base)) / (c.ticks_per_ns * 1e9);
+        }
     };
 
 
 
+    // Pays for the TSC calibration up front, call before timing anything in Cycles mode
+    inline void calibrate_tsc() {
+        HighResTimer::tsc_calibration();
+    }
+
     enum class TimerMode {
         Global,
         Process,
-        Thread
+        Thread,
+        Cycles  // Calibrated TSC, for sub-microsecond phases
     };
 
 
@@ -90,17 +215,24 @@ namespace Timer{
             case TimerMode::Global:       return HighResTimer::global_now();
             case TimerMode::Process: return HighResTimer::cpu_process_now();
             case TimerMode::Thread:  return HighResTimer::cpu_thread_now();
+            case TimerMode::Cycles:  return HighResTimer::cycles_now();
         }
         return 0.0;
     }
 
+    // Reading that closes a measurement, only differs from now() for Cycles
+    inline double now_end(TimerMode mode) {
+        if (mode == TimerMode::Cycles) return HighResTimer::cycles_now(true);
+        return now(mode);
+    }
+
     template <typename Func>
     double measure_time(Func&& f, TimerMode mode = TimerMode::Global, int runs = 1) {
         double total = 0.0;
         for (int i = 0; i < runs; i++) {
             double start = now(mode);
             f();
-            double end = now(mode);
+            double end = now_end(mode);
             total += (end - start);
         }
         return total / runs;
@@ -142,24 +274,676 @@ namespace Timer{
         return oss.str();;
     }
 
+    // Keep the compiler from optimising away a value computed inside a benchmark
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+        #if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+        #else
+            static volatile const T* sink;
+            sink = &value;
+        #endif
+    }
+
+    struct BenchmarkOptions {
+        int warmup_runs = 3;
+        int min_runs = 10;
+        int max_runs = 100000;
+        double target_time = 1.0;   // Seconds of measured runs to aim for
+        double outlier_iqr = 3.0;   // Tukey fence, drop samples more than k * IQR above the upper quartile, 0 keeps all
+    };
+
+    // All times are in seconds and ignore rejected outliers
+    struct BenchmarkResult {
+        std::string name;
+        int runs = 0;
+        int outliers = 0;
+        double mean = 0.0;
+        double median = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double stddev = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+
+        std::string to_json() const {
+            std::ostringstream oss;
+            oss << std::setprecision(9)
+                << "{\"name\":\"" << escape(name) << "\""
+                << ",\"runs\":" << runs << ",\"outliers\":" << outliers
+                << ",\"mean\":" << mean << ",\"median\":" << median
+                << ",\"p90\":" << p90 << ",\"p99\":" << p99
+                << ",\"stddev\":" << stddev << ",\"min\":" << min << ",\"max\":" << max << "}";
+            return oss.str();
+        }
+
+        void print() const {
+            std::cout << "[Bench] " << name << ": median " << formatTime(median)
+                      << " (p90 " << formatTime(p90) << ", p99 " << formatTime(p99)
+                      << ", min " << formatTime(min) << ", stddev " << formatTime(stddev) << ") over "
+                      << runs << " runs, " << outliers << " outliers\n";
+        }
+
+    private:
+        static std::string escape(const std::string& s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+    };
+
+    inline std::string to_json(const std::vector<BenchmarkResult>& results) {
+        std::string out = "[";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            if (i) out += ",\n ";
+            out += results[i].to_json();
+        }
+        return out + "]";
+    }
+
+    // Linear interpolated percentile, p in [0, 1], sorted must be sorted and non-empty
+    inline double percentile(const std::vector<double>& sorted, double p) {
+        double pos = p * (sorted.size() - 1);
+        std::size_t lo = static_cast<std::size_t>(pos);
+        std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+    }
+
+    // Summarise raw samples, rejecting slow outliers with Tukey's upper fence
+    inline BenchmarkResult summarise(std::string name, std::vector<double> samples, double outlier_iqr = 3.0) {
+        BenchmarkResult r;
+        r.name = std::move(name);
+        if (samples.empty()) return r;
+
+        std::ranges::sort(samples);
+        if (outlier_iqr > 0.0 && samples.size() >= 4) {
+            // Noise (interrupts, migrations) only ever adds time, so only slow samples are dropped
+            // The fence is kept at least 5% above the median so very tight distributions keep their tail
+            double q1 = percentile(samples, 0.25);
+            double q3 = percentile(samples, 0.75);
+            double hi = std::max(q3 + outlier_iqr * (q3 - q1), percentile(samples, 0.5) * 1.05);
+            std::size_t before = samples.size();
+            std::erase_if(samples, [&](double s) { return s > hi; });
+            r.outliers = static_cast<int>(before - samples.size());
+        }
+
+        r.runs = static_cast<int>(samples.size());
+        double sum = 0.0;
+        for (double s : samples) sum += s;
+        r.mean = sum / samples.size();
+        double var = 0.0;
+        for (double s : samples) var += (s - r.mean) * (s - r.mean);
+        r.stddev = samples.size() > 1 ? std::sqrt(var / (samples.size() - 1)) : 0.0;
+        r.median = percentile(samples, 0.5);
+        r.p90 = percentile(samples, 0.9);
+        r.p99 = percentile(samples, 0.99);
+        r.min = samples.front();
+        r.max = samples.back();
+        return r;
+    }
+
+    // Time f repeatedly after warming up
+    // The warmup runs estimate the cost of one run, which sets how many runs fit in target_time
+    template <typename Func>
+    BenchmarkResult benchmark(std::string name, Func&& f, BenchmarkOptions options = {}, TimerMode mode = TimerMode::Global) {
+        if (mode == TimerMode::Cycles) calibrate_tsc();
+        double warmup_total = 0.0;
+        for (int i = 0; i < options.warmup_runs; i++) {
+            double start = now(mode);
+            f();
+            warmup_total += now_end(mode) - start;
+        }
+
+        int runs = options.min_runs;
+        if (options.warmup_runs > 0 && warmup_total > 0.0) {
+            double estimate = warmup_total / options.warmup_runs;
+            double fit = options.target_time / estimate;
+            runs = static_cast<int>(std::clamp(fit, double(options.min_runs), double(options.max_runs)));
+        }
+
+        std::vector<double> samples;
+        samples.reserve(runs);
+        for (int i = 0; i < runs; i++) {
+            double start = now(mode);
+            f();
+            samples.push_back(now_end(mode) - start);
+        }
+        return summarise(std::move(name), std::move(samples), options.outlier_iqr);
+    }
+
+    // Hardware performance counters for the calling thread, Linux only
+    // Uses one perf_event_open group so every counter covers exactly the same instructions
+    // Counters the CPU or VM does not provide are left out, if none can be opened
+    // (not Linux, perf_event_paranoid too strict, no PMU) available() is false and reads return zeros
+    class PerfCounters {
+    public:
+        enum Event { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses, EVENT_COUNT };
+        static constexpr std::array<const char*, EVENT_COUNT> NAMES = {
+            "cycles", "instructions", "L1D misses", "LLC misses", "branch misses"
+        };
+
+        struct Sample {
+            std::array<std::uint64_t, EVENT_COUNT> values{};
+            std::uint32_t valid = 0; // Bit per Event
+
+            bool has(Event e) const { return valid & (1u << e); }
+            std::uint64_t operator[](Event e) const { return values[e]; }
+
+            Sample operator-(const Sample& other) const {
+                Sample d;
+                d.valid = valid & other.valid;
+                for (int e = 0; e < EVENT_COUNT; e++) d.values[e] = values[e] - other.values[e];
+                return d;
+            }
+
+            double ipc() const {
+                if (!has(Cycles) || !has(Instructions) || values[Cycles] == 0) return 0.0;
+                return double(values[Instructions]) / double(values[Cycles]);
+            }
+        };
+
+        PerfCounters() { open(); }
+        ~PerfCounters() { close(); }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        // Counters of the calling thread, opened on first use and kept counting
+        // Scopes take differences of reads, so nested scopes share one group
+        static PerfCounters& local() {
+            thread_local PerfCounters counters;
+            return counters;
+        }
+
+        bool available() const { return leader >= 0; }
+        const std::string& error() const { return error_message; }
+
+        // Current totals, scaled up if the kernel had to multiplex the group
+        Sample read() const {
+            Sample s;
+            #if defined(__linux__)
+                if (!available()) return s;
+                // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, value[nr]
+                std::array<std::uint64_t, 3 + EVENT_COUNT> buf{};
+                if (::read(leader, buf.data(), sizeof(buf)) < 0) return s;
+                std::uint64_t nr = buf[0], enabled = buf[1], running = buf[2];
+                if (running == 0) return s;
+                double scale = double(enabled) / double(running);
+                for (std::uint64_t i = 0; i < nr && i < order.size(); i++) {
+                    s.values[order[i]] = static_cast<std::uint64_t>(double(buf[3 + i]) * scale);
+                    s.valid |= 1u << order[i];
+                }
+            #endif
+            return s;
+        }
+
+    private:
+        int leader = -1;
+        std::array<int, EVENT_COUNT> fds{-1, -1, -1, -1, -1};
+        std::vector<Event> order; // Events in the order they joined the group
+        std::string error_message;
+
+        void open() {
+            #if defined(__linux__)
+                for (int e = 0; e < EVENT_COUNT; e++) {
+                    perf_event_attr attr{};
+                    attr.size = sizeof(attr);
+                    config(static_cast<Event>(e), attr);
+                    attr.disabled = leader < 0;
+                    attr.exclude_kernel = 1; // Allowed with perf_event_paranoid <= 2
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                    int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+                    if (fd < 0) {
+                        if (leader < 0 && error_message.empty()) {
+                            error_message = std::strerror(errno);
+                            if (errno == EACCES || errno == EPERM) error_message += " (see /proc/sys/kernel/perf_event_paranoid)";
+                            else if (errno == ENOENT) error_message += " (no hardware PMU, common in VMs)";
+                        }
+                        continue;
+                    }
+                    fds[e] = fd;
+                    order.push_back(static_cast<Event>(e));
+                    if (leader < 0) leader = fd;
+                }
+                if (leader >= 0) {
+                    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                    error_message.clear();
+                }
+            #else
+                error_message = "perf_event_open is only available on Linux";
+            #endif
+        }
+
+        void close() {
+            #if defined(__linux__)
+                for (int& fd : fds) {
+                    if (fd >= 0) ::close(fd);
+                    fd = -1;
+                }
+            #endif
+            leader = -1;
+        }
+
+        #if defined(__linux__)
+        static void config(Event e, perf_event_attr& attr) {
+            auto cache = [](std::uint64_t id) {
+                return id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            };
+            switch (e) {
+                case Cycles:       attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+                case Instructions: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+                case L1DMisses:    attr.type = PERF_TYPE_HW_CACHE; attr.config = cache(PERF_COUNT_HW_CACHE_L1D); break;
+                case LLCMisses:    attr.type = PERF_TYPE_HW_CACHE; attr.config = cache(PERF_COUNT_HW_CACHE_LL); break;
+                case BranchMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+                default: break;
+            }
+        }
+        #endif
+    };
+
+    // Print the counters spent in a scope
+    // If counters are unavailable the reason is printed once per thread and the scope does nothing
+    class PerfScope {
+        std::string name;
+        PerfCounters::Sample start;
+
+    public:
+        explicit PerfScope(std::string label) : name(std::move(label)) {
+            auto& counters = PerfCounters::local();
+            if (!counters.available()) {
+                thread_local bool warned = false;
+                if (!warned) {
+                    std::cerr << "[Perf] Counters unavailable: " << counters.error() << "\n";
+                    warned = true;
+                }
+                return;
+            }
+            start = counters.read();
+        }
+
+        ~PerfScope() {
+            auto& counters = PerfCounters::local();
+            if (!counters.available()) return;
+            print(name, counters.read() - start);
+        }
+
+        PerfScope(const PerfScope&) = delete;
+        PerfScope& operator=(const PerfScope&) = delete;
+
+        static void print(const std::string& name, const PerfCounters::Sample& d) {
+            std::ostringstream oss;
+            oss << "[Perf] " << name << ":";
+            for (int e = 0; e < PerfCounters::EVENT_COUNT; e++) {
+                auto event = static_cast<PerfCounters::Event>(e);
+                if (!d.has(event)) continue;
+                oss << " " << PerfCounters::NAMES[e] << " " << d[event] << ",";
+            }
+            oss << std::fixed << std::setprecision(2) << " IPC " << d.ipc() << "\n";
+            std::cout << oss.str();
+        }
+    };
+
+    // Hierarchical profiler
+    // Every thread records into its own tree of scopes, preallocated so the hot path
+    // is two clock reads and a short search of the parent's children, with no I/O
+    // The tree is printed by report(), which runs automatically at exit if anything was recorded
+    class Profiler {
+    public:
+        static constexpr std::size_t MAX_DEPTH = 64;
+        static constexpr std::size_t RESERVED_NODES = 1024;
+
+        struct Node {
+            std::string name;
+            std::size_t parent = 0;
+            std::size_t first_child = 0;   // 0 means none, the root is never a child
+            std::size_t next_sibling = 0;
+            std::uint64_t count = 0;
+            double total = 0.0;
+            double min = std::numeric_limits<double>::max();
+            double max = 0.0;
+        };
+
+        struct ThreadProfile {
+            std::size_t thread_index = 0;
+            std::vector<Node> nodes;
+            std::array<std::size_t, MAX_DEPTH + 1> stack{};
+            std::array<double, MAX_DEPTH + 1> starts{};
+            std::size_t depth = 0;
+            std::size_t overflow = 0; // Scopes deeper than MAX_DEPTH, not recorded
+
+            ThreadProfile() {
+                nodes.reserve(RESERVED_NODES);
+                nodes.push_back(Node{"<root>"});
+            }
+
+            void enter(std::string_view name) {
+                if (depth == MAX_DEPTH) {
+                    overflow++;
+                    return;
+                }
+                std::size_t parent = stack[depth];
+                std::size_t child = nodes[parent].first_child;
+                while (child != 0 && nodes[child].name != name) child = nodes[child].next_sibling;
+
+                if (child == 0) {
+                    child = nodes.size();
+                    Node n{std::string(name)};
+                    n.parent = parent;
+                    n.next_sibling = nodes[parent].first_child;
+                    nodes.push_back(std::move(n));
+                    nodes[parent].first_child = child;
+                }
+
+                stack[++depth] = child;
+                starts[depth] = HighResTimer::global_now();
+            }
+
+            void exit() {
+                double end = HighResTimer::global_now();
+                if (overflow > 0) {
+                    overflow--;
+                    return;
+                }
+                if (depth == 0) return;
+                Node& n = nodes[stack[depth]];
+                double elapsed = end - starts[depth];
+                n.count++;
+                n.total += elapsed;
+                n.min = std::min(n.min, elapsed);
+                n.max = std::max(n.max, elapsed);
+                depth--;
+            }
+        };
+
+        static Profiler& instance() {
+            static Profiler profiler;
+            return profiler;
+        }
+
+        // Profile of the calling thread, created on first use
+        static ThreadProfile& local() {
+            thread_local ThreadProfile* profile = instance().register_thread();
+            return *profile;
+        }
+
+        static void enter(std::string_view name) { local().enter(name); }
+        static void exit() { local().exit(); }
+
+        // Print every thread's tree, totals include time spent in children
+        void report(std::ostream& out = std::cout) {
+            std::lock_guard lock(mutex);
+            reported = true;
+            for (const auto& profile : profiles) {
+                if (profile->nodes.size() <= 1) continue;
+                out << "[Profile] Thread " << profile->thread_index << "\n";
+                out << std::left << std::setw(40) << "Scope"
+                    << std::right << std::setw(10) << "Calls"
+                    << std::setw(14) << "Total" << std::setw(14) << "Mean"
+                    << std::setw(14) << "Min" << std::setw(14) << "Max"
+                    << std::setw(10) << "%Parent" << "\n";
+                print_children(out, *profile, 0, 0);
+            }
+        }
+
+        ~Profiler() {
+            if (!reported) report();
+        }
+
+    private:
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadProfile>> profiles;
+        bool reported = false;
+
+        ThreadProfile* register_thread() {
+            std::lock_guard lock(mutex);
+            profiles.push_back(std::make_unique<ThreadProfile>());
+            profiles.back()->thread_index = profiles.size() - 1;
+            return profiles.back().get();
+        }
+
+        static void print_children(std::ostream& out, const ThreadProfile& profile, std::size_t parent, int indent);
+    };
+
+    class ProfileScope {
+    public:
+        explicit ProfileScope(std::string_view name) { Profiler::enter(name); }
+        ~ProfileScope() { Profiler::exit(); }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    };
+
+    // Chrome trace event export, open the file in chrome://tracing or ui.perfetto.dev
+    // Every ScopedTimer records a begin and an end event on its thread's timeline
+    // Off unless started with Trace::start(path) or the AOC_TRACE=path environment variable,
+    // when off a scope only pays for one relaxed atomic load
+    // Events are buffered per thread and written by stop(), which runs automatically at exit
+    class Trace {
+    public:
+        static Trace& instance() {
+            static Trace trace;
+            return trace;
+        }
+
+        static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+        // Start recording, events go to path when stopped
+        void start(std::string path) {
+            std::lock_guard lock(mutex);
+            output = std::move(path);
+            origin = HighResTimer::global_now();
+            active.store(true, std::memory_order_relaxed);
+        }
+
+        // Stop recording and write every thread's events, false if the file could not be written
+        bool stop() {
+            std::lock_guard lock(mutex);
+            if (!active.exchange(false)) return true;
+
+            std::ofstream out(output);
+            if (!out) {
+                std::cerr << "Warning: Failed to write trace '" << output << "'.\n";
+                return false;
+            }
+            out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+            bool first = true;
+            for (const auto& buffer : buffers) {
+                out << (first ? "\n" : ",\n")
+                    << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->tid
+                    << R"(,"args":{"name":"Thread )" << buffer->tid << "\"}}";
+                first = false;
+                for (const auto& e : buffer->events) {
+                    out << ",\n{\"name\":\"" << escape(e.name) << "\",\"ph\":\"" << e.phase
+                        << "\",\"ts\":" << (e.time - origin) * 1e6
+                        << ",\"pid\":1,\"tid\":" << buffer->tid << "}";
+                }
+            }
+            out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+            std::cout << "[Trace] Wrote " << output << "\n";
+            return static_cast<bool>(out);
+        }
+
+        static void begin(std::string_view name) { local().events.push_back(Event{std::string(name), 'B', HighResTimer::global_now()}); }
+        static void end(std::string_view name) { local().events.push_back(Event{std::string(name), 'E', HighResTimer::global_now()}); }
+
+        ~Trace() { stop(); }
+
+    private:
+        struct Event {
+            std::string name;
+            char phase;
+            double time;
+        };
+
+        struct Buffer {
+            std::size_t tid = 0;
+            std::vector<Event> events;
+        };
+
+        static inline std::atomic<bool> active{false};
+
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Buffer>> buffers;
+        std::string output;
+        double origin = 0.0;
+
+        Trace() {
+            if (const char* path = std::getenv("AOC_TRACE"); path && *path) start(path);
+        }
+
+        // Buffer of the calling thread, created on first use
+        static Buffer& local() {
+            thread_local Buffer* buffer = instance().register_thread();
+            return *buffer;
+        }
+
+        Buffer* register_thread() {
+            std::lock_guard lock(mutex);
+            buffers.push_back(std::make_unique<Buffer>());
+            buffers.back()->tid = buffers.size();
+            buffers.back()->events.reserve(1024);
+            return buffers.back().get();
+        }
+
+        static std::string escape(std::string_view s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+    };
+
+    // Reads AOC_TRACE before main, so tracing covers the whole run
+    inline Trace& trace_from_environment = Trace::instance();
+
+    // Silences ScopedTimer output, profiles and perf counters are unaffected
+    // Set by the multi-day runner, which prints its own timing table
+    inline std::atomic<bool> quiet{false};
+
     class ScopedTimer {
         std::string name;
         TimerMode mode;
         double start;
+        #ifdef AOC_PERF_COUNTERS
+            std::optional<PerfScope> perf;
+        #endif
+        #ifdef AOC_TRACK_ALLOCATIONS
+            std::optional<AllocTracker::Scope> allocs;
+        #endif
 
     public:
         ScopedTimer(std::string label, TimerMode m = TimerMode::Global)
-            : name(std::move(label)), mode(m), start(now(m)) {}
+            : name(std::move(label)), mode(m) {
+            // Before the profiler, the trace or the clock see this scope
+            if (m == TimerMode::Cycles) calibrate_tsc();
+            #ifdef AOC_PROFILE
+                Profiler::enter(name);
+            #endif
+            if (Trace::enabled()) Trace::begin(name);
+            #ifdef AOC_PERF_COUNTERS
+                perf.emplace(name);
+            #endif
+            #ifdef AOC_TRACK_ALLOCATIONS
+                allocs.emplace();
+            #endif
+            start = now(m);
+        }
 
         ~ScopedTimer() {
-            double end = now(mode);
+            double end = now_end(mode);
+            #ifdef AOC_TRACK_ALLOCATIONS
+                // Close the scope first so printing below is not counted
+                AllocTracker::Counters counters = allocs->get();
+                allocs.reset();
+            #endif
+            #ifdef AOC_PERF_COUNTERS
+                perf.reset();
+            #endif
+            if (Trace::enabled()) Trace::end(name);
+            #ifdef AOC_PROFILE
+                Profiler::exit();
+            #endif
+            if (quiet) return;
             double elapsed = end - start;
             std::string modeName = (mode == TimerMode::Global) ? "Global"
                                 : (mode == TimerMode::Process) ? "CPU(Process)"
-                                : "CPU(Thread)";
+                                : (mode == TimerMode::Thread) ? "CPU(Thread)"
+                                : "Cycles";
             std::cout << "[Timer] " << name << " (" << modeName << "): "
-                    << formatTime(elapsed) << "\n";
+                    << formatTime(elapsed);
+            if (mode == TimerMode::Cycles && HighResTimer::tsc_calibration().usable) {
+                std::cout << " (" << std::llround(elapsed * HighResTimer::tsc_calibration().ticks_per_ns * 1e9) << " cycles)";
+            }
+            std::cout
+                    #ifdef AOC_TRACK_ALLOCATIONS
+                        << ", " << AllocTracker::format(counters)
+                    #endif
+                    << "\n";
         }
     };
 
-}
\ No newline at end of file
+    inline void Profiler::print_children(std::ostream& out, const ThreadProfile& profile, std::size_t parent, int indent) {
+        // Children are linked newest first, print them in the order they were first entered
+        std::vector<std::size_t> children;
+        for (std::size_t c = profile.nodes[parent].first_child; c != 0; c = profile.nodes[c].next_sibling) {
+            children.push_back(c);
+        }
+        std::ranges::reverse(children);
+
+        double parent_total = 0.0;
+        if (parent != 0) {
+            parent_total = profile.nodes[parent].total;
+        } else {
+            for (std::size_t c : children) parent_total += profile.nodes[c].total;
+        }
+
+        for (std::size_t c : children) {
+            const Node& n = profile.nodes[c];
+            double pct = parent_total > 0.0 ? 100.0 * n.total / parent_total : 0.0;
+            std::ostringstream pct_str;
+            pct_str << std::fixed << std::setprecision(1) << pct << "%";
+
+            // setw counts bytes, pad by characters so "µs" lines up
+            auto time = [](double seconds) {
+                std::string t = formatTime(seconds);
+                auto chars = std::ranges::count_if(t, [](unsigned char ch) { return (ch & 0xC0) != 0x80; });
+                return std::string(std::max<std::ptrdiff_t>(0, 14 - chars), ' ') + t;
+            };
+
+            out << std::left << std::setw(40) << (std::string(indent * 2, ' ') + n.name)
+                << std::right << std::setw(10) << n.count
+                << time(n.total)
+                << time(n.count ? n.total / n.count : 0.0)
+                << time(n.count ? n.min : 0.0)
+                << time(n.max)
+                << std::setw(10) << pct_str.str() << "\n";
+            print_children(out, profile, c, indent + 1);
+        }
+    }
+
+}
+
+// Profile a scope only when built with AOC_PROFILE, otherwise compiles to nothing
+// Cheap enough to use inside hot loops
+#define TIMER_CONCAT_INNER(a, b) a##b
+#define TIMER_CONCAT(a, b) TIMER_CONCAT_INNER(a, b)
+#ifdef AOC_PROFILE
+    #define PROFILE_SCOPE(name) ::Timer::ProfileScope TIMER_CONCAT(profile_scope_, __LINE__)(name)
+#else
+    #define PROFILE_SCOPE(name) ((void)0)
+#endif
+
+// Hardware counters for a scope only when built with AOC_PERF_COUNTERS, otherwise compiles to nothing
+#ifdef AOC_PERF_COUNTERS
+    #define PERF_SCOPE(name) ::Timer::PerfScope TIMER_CONCAT(perf_scope_, __LINE__)(name)
+#else
+    #define PERF_SCOPE(name) ((void)0)
+#endif